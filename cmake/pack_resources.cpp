@@ -0,0 +1,133 @@
+// Build-time packer for app:// web resources (see src/cef/resource_pack.h)
+// Usage: pack_resources <output.pak> <base_url> <resource_dir> <file>...
+
+#include "cef/lz4_block.h"
+#include "cef/resource_pack.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace resource_pack;
+
+static const char* mimeType(const std::string& ext) {
+    if (ext == ".html") return "text/html";
+    if (ext == ".css") return "text/css";
+    if (ext == ".js") return "application/javascript";
+    if (ext == ".png") return "image/png";
+    if (ext == ".jpg" || ext == ".jpeg") return "image/jpeg";
+    if (ext == ".svg") return "image/svg+xml";
+    if (ext == ".json") return "application/json";
+    if (ext == ".woff2") return "font/woff2";
+    if (ext == ".woff") return "font/woff";
+    if (ext == ".ttf") return "font/ttf";
+    return "application/octet-stream";
+}
+
+static uint64_t fnv1a64(const std::vector<uint8_t>& data) {
+    uint64_t h = 14695981039346656037ull;
+    for (uint8_t c : data) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+struct Input {
+    std::string path;  // URL path, e.g. "resources/index.html"
+    std::string mime;
+    std::vector<uint8_t> stored;
+    uint32_t size = 0;
+    uint32_t flags = 0;
+    uint64_t hash = 0;
+};
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        fprintf(stderr, "usage: %s <output.pak> <base_url> <resource_dir> <file>...\n", argv[0]);
+        return 1;
+    }
+    fs::path output = argv[1];
+    std::string base_url = argv[2];
+    fs::path resource_dir = argv[3];
+
+    std::vector<Input> inputs;
+    for (int i = 4; i < argc; i++) {
+        fs::path file = argv[i];
+        std::ifstream in(file, std::ios::binary);
+        if (!in) {
+            fprintf(stderr, "pack_resources: cannot read %s\n", argv[i]);
+            return 1;
+        }
+        std::vector<uint8_t> raw((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        Input input;
+        input.path = base_url + "/" + fs::relative(file, resource_dir).generic_string();
+        input.mime = mimeType(file.extension().string());
+        input.size = static_cast<uint32_t>(raw.size());
+        input.hash = fnv1a64(raw);
+
+        // Keep the compressed form only when it saves at least 1/8
+        std::vector<uint8_t> packed(lz4CompressBound(raw.size()));
+        size_t packed_size = lz4Compress(raw.data(), raw.size(), packed.data(), packed.size());
+        if (packed_size > 0 && packed_size < raw.size() - raw.size() / 8) {
+            packed.resize(packed_size);
+            input.stored = std::move(packed);
+            input.flags = PACK_LZ4;
+        } else {
+            input.stored = std::move(raw);
+        }
+        inputs.push_back(std::move(input));
+    }
+    std::sort(inputs.begin(), inputs.end(), [](const Input& a, const Input& b) { return a.path < b.path; });
+
+    // Lay out: header, entry table, string table, data
+    std::vector<PackEntry> entries(inputs.size(), PackEntry{});
+    std::string strings;
+    uint64_t strings_start = sizeof(PackHeader) + entries.size() * sizeof(PackEntry);
+    for (size_t i = 0; i < inputs.size(); i++) {
+        entries[i].path_offset = static_cast<uint32_t>(strings_start + strings.size());
+        entries[i].path_len = static_cast<uint16_t>(inputs[i].path.size());
+        strings += inputs[i].path;
+        entries[i].mime_offset = static_cast<uint32_t>(strings_start + strings.size());
+        entries[i].mime_len = static_cast<uint16_t>(inputs[i].mime.size());
+        strings += inputs[i].mime;
+    }
+    uint64_t data_offset = strings_start + strings.size();
+    size_t raw_total = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        entries[i].flags = inputs[i].flags;
+        entries[i].data_offset = data_offset;
+        entries[i].stored_size = static_cast<uint32_t>(inputs[i].stored.size());
+        entries[i].size = inputs[i].size;
+        entries[i].hash = inputs[i].hash;
+        data_offset += inputs[i].stored.size();
+        raw_total += inputs[i].size;
+    }
+
+    PackHeader header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.count = static_cast<uint32_t>(entries.size());
+
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(PackEntry));
+    out.write(strings.data(), strings.size());
+    for (const auto& input : inputs) {
+        out.write(reinterpret_cast<const char*>(input.stored.data()), input.stored.size());
+    }
+    if (!out) {
+        fprintf(stderr, "pack_resources: cannot write %s\n", argv[1]);
+        return 1;
+    }
+
+    printf("pack_resources: %zu files, %zu -> %llu bytes\n", inputs.size(), raw_total,
+           static_cast<unsigned long long>(data_offset));
+    return 0;
+}
@@ -1,11 +1,38 @@
 #include "browser_stack.h"
 #include "include/cef_browser.h"
 #include "../logging.h"
+#include "../stats.h"
+#include "../trace.h"
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 
+namespace {
+
+// Times a texture upload or import into the upload counters
+class UploadTimer {
+public:
+    UploadTimer() : start_(std::chrono::steady_clock::now()) {}
+    void done() {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count();
+        stats::add(stats::g_counters.uploads);
+        stats::add(stats::g_counters.upload_ns, static_cast<uint64_t>(ns));
+    }
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace
+
 // BrowserEntry implementation
 
+BrowserEntry::~BrowserEntry() {
+    for (auto& buf : paint_buffers) {
+        stats::adjust(stats::g_counters.paint_buffer_bytes, -static_cast<int64_t>(buf.data.capacity()));
+    }
+}
+
 void BrowserEntry::setCompositor(std::unique_ptr<Compositor> comp) {
     compositor = std::move(comp);
 }
@@ -52,11 +79,21 @@ std::function<void(const void*, int, int)> BrowserEntry::makePaintCallback() {
         auto& buf = paint_buffers[write_idx];
         size_t size = static_cast<size_t>(w) * h * 4;
         if (buf.data.size() < size) {
+            size_t old_capacity = buf.data.capacity();
             buf.data.resize(size);
+            stats::adjust(stats::g_counters.paint_buffer_bytes,
+                          static_cast<int64_t>(buf.data.capacity()) - static_cast<int64_t>(old_capacity));
         }
         std::memcpy(buf.data.data(), buffer, size);
         buf.width = w;
         buf.height = h;
+        // Arrow to the upload that consumes this frame; a superseded frame's
+        // flow is left open
+        buf.flow = 0;
+        if (trace::enabled()) {
+            buf.flow = trace::newFlowId();
+            trace::flowBegin("paint", buf.flow);
+        }
 
         // Swap buffers (brief lock)
         {
@@ -64,6 +101,8 @@ std::function<void(const void*, int, int)> BrowserEntry::makePaintCallback() {
             buf.dirty = true;
             paint_write_idx.store(1 - write_idx, std::memory_order_release);
         }
+        paint_pending.store(true);
+        stats::add(stats::g_counters.cef_paints);
 
         // Wake main loop to process the new frame
         if (wake_main_loop) {
@@ -77,8 +116,13 @@ void BrowserEntry::flushPaintBuffer() {
     int read_idx = 1 - paint_write_idx.load(std::memory_order_acquire);
     auto& buf = paint_buffers[read_idx];
     if (buf.dirty && !buf.data.empty()) {
+        TRACE_SCOPE("flushPaintBuffer");
+        if (buf.flow) TRACE_FLOW_END("paint", buf.flow);
+        UploadTimer timer;
         compositor->updateOverlayPartial(buf.data.data(), buf.width, buf.height);
+        timer.done();
         buf.dirty = false;
+        stats::add(stats::g_counters.upload_bytes, static_cast<uint64_t>(buf.width) * buf.height * 4);
     }
 }
 
@@ -87,7 +131,8 @@ void BrowserEntry::importQueued() {
     compositor->importQueuedIOSurface();
 #elif !defined(_WIN32)
     // Linux: import queued dmabuf
-    compositor->importQueuedDmabuf();
+    UploadTimer timer;
+    if (compositor->importQueuedDmabuf()) timer.done();
 #endif
     // Windows: no-op (no GPU texture import path)
 }
@@ -188,13 +233,13 @@ void BrowserStack::flushAll() {
 void BrowserStack::setAlpha(const std::string& name, float alpha) {
     auto* entry = get(name);
     if (entry) {
-        entry->alpha = alpha;
+        entry->alpha.store(alpha);
     }
 }
 
 float BrowserStack::getAlpha(const std::string& name) const {
     auto* entry = get(name);
-    return entry ? entry->alpha : 0.0f;
+    return entry ? entry->alpha.load() : 0.0f;
 }
 
 void BrowserStack::resizeAll(int logical_w, int logical_h, int physical_w, int physical_h) {
@@ -209,6 +254,12 @@ void BrowserStack::resizeAll(int width, int height) {
     }
 }
 
+void BrowserStack::resizeCompositors(int physical_w, int physical_h) {
+    for (auto& entry : browsers_) {
+        entry->compositor->resize(physical_w, physical_h);
+    }
+}
+
 void BrowserStack::notifyAllScreenInfoChanged() {
     for (auto& entry : browsers_) {
         entry->notifyScreenInfoChanged();
@@ -246,22 +297,36 @@ void BrowserStack::cleanupCompositors() {
     }
 }
 
-void BrowserStack::renderAll(int width, int height) {
+void BrowserStack::renderAll(int width, int height, bool stretch) {
+#ifdef __APPLE__
+    (void)stretch;
+#endif
     for (auto& entry : browsers_) {
         entry->flushPaintBuffer();
         entry->importQueued();
         entry->flushOverlay();
+#ifndef __APPLE__
+        entry->compositor->setStretchToView(stretch);
+#endif
         if (entry->compositor->hasValidOverlay() || entry->compositor->hasPendingContent()) {
-            entry->compositor->composite(width, height, entry->alpha);
+            entry->compositor->composite(width, height, entry->alpha.load());
         }
     }
 }
 
 bool BrowserStack::anyHasPendingContent() const {
+    // Only paints not yet submitted: compositor state is consumed on the
+    // compositor thread (Linux), so polling it would spin until the swap
     for (const auto& entry : browsers_) {
-        if (entry->compositor->hasPendingContent()) {
+        if (entry->paint_pending.load()) {
             return true;
         }
     }
     return false;
 }
+
+void BrowserStack::markPaintsSubmitted() {
+    for (auto& entry : browsers_) {
+        entry->paint_pending.store(false);
+    }
+}
@@ -48,6 +48,7 @@ struct PaintBuffer {
     int width = 0;
     int height = 0;
     bool dirty = false;
+    uint64_t flow = 0;  // trace flow from the paint to its upload, 0 when off
 };
 
 // Per-browser state container
@@ -62,10 +63,13 @@ struct BrowserEntry {
     std::array<PaintBuffer, 2> paint_buffers;
     std::atomic<int> paint_write_idx{0};
     std::mutex paint_swap_mutex;
+    std::atomic<bool> paint_pending{false};  // paint not yet taken into a frame (main thread clears)
     std::unique_ptr<Compositor> compositor;  // owned
-    float alpha = 1.0f;
+    std::atomic<float> alpha{1.0f};  // written by the main thread, read when compositing
     std::function<void()> wake_main_loop;  // Called after paint to wake main loop
 
+    ~BrowserEntry();
+
     // Set a pre-created compositor (for macOS pre-init optimization)
     void setCompositor(std::unique_ptr<Compositor> comp);
 
@@ -126,6 +130,9 @@ public:
     // Legacy resize (logical only, no compositor resize)
     void resizeAll(int width, int height);
 
+    // Compositor half of resizeAll, for the thread owning the GL context
+    void resizeCompositors(int physical_w, int physical_h);
+
     // Notify all browsers of screen info change
     void notifyAllScreenInfoChanged();
 
@@ -141,8 +148,9 @@ public:
     // Cleanup all compositors (call before destroying graphics context)
     void cleanupCompositors();
 
-    // Flush paint buffers, import GPU textures, and composite all visible browsers
-    void renderAll(int width, int height);
+    // Flush paint buffers, import GPU textures, and composite all visible browsers.
+    // stretch: scale frames painted at another size over the view (live resize)
+    void renderAll(int width, int height, bool stretch = false);
 
     // Check if stack is empty
     bool empty() const { return browsers_.empty(); }
@@ -153,6 +161,10 @@ public:
     // Check if any browser has pending content to render
     bool anyHasPendingContent() const;
 
+    // Main thread, before rendering: paints seen so far go into this frame.
+    // A paint landing after this re-arms the flag and gets its own frame.
+    void markPaintsSubmitted();
+
 private:
     std::vector<std::unique_ptr<BrowserEntry>> browsers_;  // z-order: back to front
     std::unordered_map<std::string, BrowserEntry*> by_name_;
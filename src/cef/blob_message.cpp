@@ -0,0 +1,66 @@
+#include "cef/blob_message.h"
+#include "include/cef_shared_process_message_builder.h"
+#include "logging.h"
+#include <cstring>
+
+CefRefPtr<CefProcessMessage> createBlobMessage(const std::string& name, const std::string& header,
+                                               const void* data, size_t size) {
+    if (size < BLOB_SHARED_THRESHOLD) {
+        CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create(name);
+        CefRefPtr<CefListValue> args = msg->GetArgumentList();
+        args->SetString(0, header);
+        if (data && size > 0) {
+            args->SetBinary(1, CefBinaryValue::Create(data, size));
+        }
+        return msg;
+    }
+
+    uint32_t header_len = static_cast<uint32_t>(header.size());
+    size_t total = sizeof(header_len) + header_len + size;
+    CefRefPtr<CefSharedProcessMessageBuilder> builder = CefSharedProcessMessageBuilder::Create(name, total);
+    if (!builder || !builder->IsValid()) {
+        LOG_ERROR(LOG_CEF, "Shared message alloc failed: %s (%zu bytes)", name.c_str(), total);
+        return nullptr;
+    }
+    auto* mem = static_cast<uint8_t*>(builder->Memory());
+    memcpy(mem, &header_len, sizeof(header_len));
+    memcpy(mem + sizeof(header_len), header.data(), header_len);
+    memcpy(mem + sizeof(header_len) + header_len, data, size);
+    return builder->Build();
+}
+
+bool sendBlobMessage(CefRefPtr<CefFrame> frame, CefProcessId target, const std::string& name,
+                     const std::string& header, const void* data, size_t size) {
+    if (!frame) return false;
+    CefRefPtr<CefProcessMessage> msg = createBlobMessage(name, header, data, size);
+    if (!msg) return false;
+    frame->SendProcessMessage(target, msg);
+    return true;
+}
+
+bool readBlobMessage(CefRefPtr<CefProcessMessage> message, BlobMessage& out) {
+    CefRefPtr<CefSharedMemoryRegion> region = message->GetSharedMemoryRegion();
+    if (region && region->IsValid()) {
+        size_t total = region->Size();
+        const auto* mem = static_cast<const uint8_t*>(region->Memory());
+        uint32_t header_len = 0;
+        if (total < sizeof(header_len)) return false;
+        memcpy(&header_len, mem, sizeof(header_len));
+        if (header_len > total - sizeof(header_len)) return false;
+        out.header.assign(reinterpret_cast<const char*>(mem + sizeof(header_len)), header_len);
+        out.data = mem + sizeof(header_len) + header_len;
+        out.size = total - sizeof(header_len) - header_len;
+        out.region = region;
+        return true;
+    }
+
+    CefRefPtr<CefListValue> args = message->GetArgumentList();
+    if (!args || args->GetSize() < 1) return false;
+    out.header = args->GetString(0).ToString();
+    if (args->GetSize() > 1 && args->GetType(1) == VTYPE_BINARY) {
+        out.binary = args->GetBinary(1);
+        out.data = static_cast<const uint8_t*>(out.binary->GetRawData());
+        out.size = out.binary->GetSize();
+    }
+    return true;
+}
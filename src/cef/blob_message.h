@@ -0,0 +1,35 @@
+#pragma once
+
+#include "include/cef_frame.h"
+#include "include/cef_process_message.h"
+#include "include/cef_shared_memory_region.h"
+#include "include/cef_values.h"
+#include <cstdint>
+#include <string>
+
+// Binary payload IPC between browser and renderer processes.
+// Payloads at or above BLOB_SHARED_THRESHOLD travel in a shared memory region
+// laid out as [uint32 header length][header][payload]; smaller ones use a
+// regular list message (string header, binary payload). Receivers handle both.
+constexpr size_t BLOB_SHARED_THRESHOLD = 64 * 1024;
+
+struct BlobMessage {
+    std::string header;             // e.g. mime type
+    const uint8_t* data = nullptr;  // valid while this struct is alive
+    size_t size = 0;
+
+    // Keep the backing storage alive
+    CefRefPtr<CefSharedMemoryRegion> region;
+    CefRefPtr<CefBinaryValue> binary;
+};
+
+// Build a blob message (nullptr if shared memory allocation fails)
+CefRefPtr<CefProcessMessage> createBlobMessage(const std::string& name, const std::string& header,
+                                               const void* data, size_t size);
+
+// Build and send in one step
+bool sendBlobMessage(CefRefPtr<CefFrame> frame, CefProcessId target, const std::string& name,
+                     const std::string& header, const void* data, size_t size);
+
+// Parse a message built by createBlobMessage (false if malformed)
+bool readBlobMessage(CefRefPtr<CefProcessMessage> message, BlobMessage& out);
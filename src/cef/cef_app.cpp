@@ -1,13 +1,49 @@
 #include "cef/cef_app.h"
 #include "cef/resource_handler.h"
+#include "cef/blob_message.h"
 #include "settings.h"
 #include "embedded_js.h"
 #include "include/cef_browser.h"
 #include "include/cef_command_line.h"
 #include "include/cef_frame.h"
+#include <chrono>
 #include <cstring>
 #include "logging.h"
 
+namespace {
+
+// Call window[fn](header, ArrayBuffer) in the frame's context
+void deliverBlobToJS(CefRefPtr<CefFrame> frame, const char* fn, const BlobMessage& blob) {
+    CefRefPtr<CefV8Context> context = frame->GetV8Context();
+    if (!context || !context->Enter()) return;
+    CefRefPtr<CefV8Value> callback = context->GetGlobal()->GetValue(fn);
+    if (callback && callback->IsFunction()) {
+        CefV8ValueList args;
+        args.push_back(CefV8Value::CreateString(blob.header));
+        args.push_back(CefV8Value::CreateArrayBufferWithCopy(const_cast<uint8_t*>(blob.data), blob.size));
+        callback->ExecuteFunction(nullptr, args);
+    }
+    context->Exit();
+}
+
+// Payload bytes of an ArrayBuffer or (UTF-8) string argument
+bool v8Bytes(const CefRefPtr<CefV8Value>& value, std::string& storage, const void*& data, size_t& size) {
+    if (value->IsArrayBuffer()) {
+        data = value->GetArrayBufferData();
+        size = value->GetArrayBufferByteLength();
+        return true;
+    }
+    if (value->IsString()) {
+        storage = value->GetStringValue().ToString();
+        data = storage.data();
+        size = storage.size();
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
 void App::OnBeforeCommandLineProcessing(const CefString& process_type,
                                         CefRefPtr<CefCommandLine> command_line) {
     // Disable all Google services
@@ -112,7 +148,28 @@ void App::DoWork() {
 void App::OnContextCreated(CefRefPtr<CefBrowser> browser,
                            CefRefPtr<CefFrame> frame,
                            CefRefPtr<CefV8Context> context) {
-    LOG_DEBUG(LOG_CEF, "OnContextCreated: %s", frame->GetURL().ToString().c_str());
+    auto start = std::chrono::steady_clock::now();
+    std::string url = frame->GetURL().ToString();
+
+    if (url.empty() || url.rfind("about:", 0) == 0) {
+        LOG_DEBUG(LOG_CEF, "OnContextCreated: %s (skipped)", url.c_str());
+        return;
+    }
+    static const std::string clipboard_shim = embedded_js.at("clipboard-shim.js");
+
+    // Iframes only get clipboard support: paste and copy target the focused frame
+    if (!frame->IsMain()) {
+        CefRefPtr<NativeV8Handler> handler = new NativeV8Handler(browser);
+        CefRefPtr<CefV8Value> jmpNative = CefV8Value::CreateObject(nullptr, nullptr);
+        jmpNative->SetValue("setClipboard", CefV8Value::CreateFunction("setClipboard", handler), V8_PROPERTY_ATTRIBUTE_READONLY);
+        context->GetGlobal()->SetValue("jmpNative", jmpNative, V8_PROPERTY_ATTRIBUTE_READONLY);
+        frame->ExecuteJavaScript(clipboard_shim, "app://native/clipboard.js", 0);
+        LOG_DEBUG(LOG_CEF, "OnContextCreated: %s (clipboard shim)", url.c_str());
+        return;
+    }
+
+    // The overlay (embedded app:// page) only needs the native shim, not the player
+    bool overlay = url.rfind("app://", 0) == 0;
 
     // Load settings (renderer process is separate from browser process)
     Settings::instance().load();
@@ -136,6 +193,7 @@ void App::OnContextCreated(CefRefPtr<CefBrowser> browser,
     jmpNative->SetValue("saveServerUrl", CefV8Value::CreateFunction("saveServerUrl", handler), V8_PROPERTY_ATTRIBUTE_READONLY);
     jmpNative->SetValue("loadServer", CefV8Value::CreateFunction("loadServer", handler), V8_PROPERTY_ATTRIBUTE_READONLY);
     jmpNative->SetValue("checkServerConnectivity", CefV8Value::CreateFunction("checkServerConnectivity", handler), V8_PROPERTY_ATTRIBUTE_READONLY);
+    jmpNative->SetValue("cancelServerConnectivity", CefV8Value::CreateFunction("cancelServerConnectivity", handler), V8_PROPERTY_ATTRIBUTE_READONLY);
     jmpNative->SetValue("notifyMetadata", CefV8Value::CreateFunction("notifyMetadata", handler), V8_PROPERTY_ATTRIBUTE_READONLY);
     jmpNative->SetValue("notifyPosition", CefV8Value::CreateFunction("notifyPosition", handler), V8_PROPERTY_ATTRIBUTE_READONLY);
     jmpNative->SetValue("notifySeek", CefV8Value::CreateFunction("notifySeek", handler), V8_PROPERTY_ATTRIBUTE_READONLY);
@@ -145,24 +203,27 @@ void App::OnContextCreated(CefRefPtr<CefBrowser> browser,
     jmpNative->SetValue("notifyRateChange", CefV8Value::CreateFunction("notifyRateChange", handler), V8_PROPERTY_ATTRIBUTE_READONLY);
     jmpNative->SetValue("setClipboard", CefV8Value::CreateFunction("setClipboard", handler), V8_PROPERTY_ATTRIBUTE_READONLY);
     jmpNative->SetValue("getClipboard", CefV8Value::CreateFunction("getClipboard", handler), V8_PROPERTY_ATTRIBUTE_READONLY);
+    jmpNative->SetValue("serverUrl", CefV8Value::CreateString(Settings::instance().serverUrl()), V8_PROPERTY_ATTRIBUTE_READONLY);
     window->SetValue("jmpNative", jmpNative, V8_PROPERTY_ATTRIBUTE_READONLY);
 
-    // Inject the JavaScript shim that creates window.api, window.NativeShell, etc.
-    std::string shim_str(embedded_js.at("native-shim.js"));
-
-    // Replace placeholder with saved server URL
-    std::string placeholder = "__SERVER_URL__";
-    size_t pos = shim_str.find(placeholder);
-    if (pos != std::string::npos) {
-        shim_str.replace(pos, placeholder.length(), Settings::instance().serverUrl());
+    // Inject the shim (window.api, window.NativeShell, ...) and player plugins as one
+    // script. Source and script URL never change, so V8's compilation cache serves
+    // repeat navigations without reparsing.
+    static const std::string shim_bundle = clipboard_shim + "\n;\n" + embedded_js.at("native-shim.js") + "\n;\n";
+    static const std::string player_bundle = shim_bundle +
+        embedded_js.at("mpv-player-core.js") + "\n;\n" +
+        embedded_js.at("mpv-video-player.js") + "\n;\n" +
+        embedded_js.at("mpv-audio-player.js") + "\n;\n" +
+        embedded_js.at("input-plugin.js");
+    if (overlay) {
+        frame->ExecuteJavaScript(shim_bundle, "app://native/shim.js", 0);
+    } else {
+        frame->ExecuteJavaScript(player_bundle, "app://native/player.js", 0);
     }
-    frame->ExecuteJavaScript(shim_str, frame->GetURL(), 0);
 
-    // Inject the player plugins
-    frame->ExecuteJavaScript(embedded_js.at("mpv-player-core.js"), frame->GetURL(), 0);
-    frame->ExecuteJavaScript(embedded_js.at("mpv-video-player.js"), frame->GetURL(), 0);
-    frame->ExecuteJavaScript(embedded_js.at("mpv-audio-player.js"), frame->GetURL(), 0);
-    frame->ExecuteJavaScript(embedded_js.at("input-plugin.js"), frame->GetURL(), 0);
+    LOG_DEBUG(LOG_CEF, "OnContextCreated: %s (%s shims, %lldus)", url.c_str(), overlay ? "overlay" : "player",
+              static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - start).count()));
 }
 
 bool App::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser,
@@ -186,15 +247,11 @@ bool App::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser,
         return true;
     }
 
-    if (name == "clipboardResult") {
-        CefRefPtr<CefListValue> args = message->GetArgumentList();
-        std::string mimeType = args->GetString(0).ToString();
-        std::string base64Data = args->GetString(1).ToString();
-        // base64 is safe for JS strings (no escaping needed)
-        std::string js = "if (window._onClipboardResult) {"
-                        "  window._onClipboardResult('" + mimeType + "', '" + base64Data + "');"
-                        "}";
-        frame->ExecuteJavaScript(js, frame->GetURL(), 0);
+    if (name == "clipboardResult" || name == "pasteData") {
+        BlobMessage blob;
+        if (readBlobMessage(message, blob)) {
+            deliverBlobToJS(frame, name == "pasteData" ? "_nativePaste" : "_onClipboardResult", blob);
+        }
         return true;
     }
 
@@ -336,9 +393,8 @@ bool NativeV8Handler::Execute(const CefString& name,
         if (arguments.size() >= 1 && arguments[0]->IsString()) {
             std::string metadata = arguments[0]->GetStringValue().ToString();
             LOG_DEBUG(LOG_CEF, "V8 notifyMetadata: %.100s...", metadata.c_str());
-            CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("notifyMetadata");
-            msg->GetArgumentList()->SetString(0, metadata);
-            browser_->GetMainFrame()->SendProcessMessage(PID_BROWSER, msg);
+            sendBlobMessage(browser_->GetMainFrame(), PID_BROWSER, "notifyMetadata", "",
+                            metadata.data(), metadata.size());
         }
         return true;
     }
@@ -374,12 +430,13 @@ bool NativeV8Handler::Execute(const CefString& name,
         return true;
     }
 
+    // notifyArtwork(imageUrl)
     if (name == "notifyArtwork") {
         if (arguments.size() >= 1 && arguments[0]->IsString()) {
-            std::string artworkUri = arguments[0]->GetStringValue().ToString();
-            LOG_DEBUG(LOG_CEF, "V8 notifyArtwork: %.50s...", artworkUri.c_str());
+            std::string url = arguments[0]->GetStringValue().ToString();
+            LOG_DEBUG(LOG_CEF, "V8 notifyArtwork: %s", url.c_str());
             CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("notifyArtwork");
-            msg->GetArgumentList()->SetString(0, artworkUri);
+            msg->GetArgumentList()->SetString(0, url);
             browser_->GetMainFrame()->SendProcessMessage(PID_BROWSER, msg);
         }
         return true;
@@ -437,19 +494,36 @@ bool NativeV8Handler::Execute(const CefString& name,
             LOG_DEBUG(LOG_CEF, "V8 checkServerConnectivity: %s", url.c_str());
             CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("checkServerConnectivity");
             msg->GetArgumentList()->SetString(0, url);
+            // Optional explicit candidate URLs; otherwise derived from the input
+            if (arguments.size() >= 2 && arguments[1]->IsArray()) {
+                CefRefPtr<CefListValue> candidates = CefListValue::Create();
+                for (int i = 0; i < arguments[1]->GetArrayLength(); i++) {
+                    CefRefPtr<CefV8Value> item = arguments[1]->GetValue(i);
+                    if (item && item->IsString()) {
+                        candidates->SetString(candidates->GetSize(), item->GetStringValue());
+                    }
+                }
+                msg->GetArgumentList()->SetList(1, candidates);
+            }
             browser_->GetMainFrame()->SendProcessMessage(PID_BROWSER, msg);
         }
         return true;
     }
 
+    if (name == "cancelServerConnectivity") {
+        CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("cancelServerConnectivity");
+        browser_->GetMainFrame()->SendProcessMessage(PID_BROWSER, msg);
+        return true;
+    }
+
+    // setClipboard(mimeType, ArrayBuffer | text)
     if (name == "setClipboard") {
-        if (arguments.size() >= 2 && arguments[0]->IsString() && arguments[1]->IsString()) {
+        std::string storage;
+        const void* data = nullptr;
+        size_t size = 0;
+        if (arguments.size() >= 2 && arguments[0]->IsString() && v8Bytes(arguments[1], storage, data, size)) {
             std::string mimeType = arguments[0]->GetStringValue().ToString();
-            std::string base64Data = arguments[1]->GetStringValue().ToString();
-            CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("setClipboard");
-            msg->GetArgumentList()->SetString(0, mimeType);
-            msg->GetArgumentList()->SetString(1, base64Data);
-            browser_->GetMainFrame()->SendProcessMessage(PID_BROWSER, msg);
+            sendBlobMessage(browser_->GetMainFrame(), PID_BROWSER, "setClipboard", mimeType, data, size);
         }
         return true;
     }
@@ -1,11 +1,15 @@
 #include "cef/cef_client.h"
+#include "cef/blob_message.h"
 #include "ui/menu_overlay.h"
 #include "settings.h"
 #include "input/sdl_to_vk.h"
+#include "player/artwork_cache.h"
+#include "include/cef_task.h"
 #include "include/cef_urlrequest.h"
 #include "include/cef_parser.h"
 #include <SDL3/SDL.h>
 #include "logging.h"
+#include "trace.h"
 #include <mutex>
 #if !defined(__APPLE__) && !defined(_WIN32)
 #include <unistd.h>  // For dup()
@@ -22,7 +26,7 @@ void doCopy(CefRefPtr<CefBrowser> browser, bool cut) {
         R"((function() {
             const text = window.getSelection().toString();
             if (text) {
-                window.jmpNative?.setClipboard?.('text/plain', btoa(text));
+                window.jmpNative?.setClipboard?.('text/plain', text);
             }
             document.execCommand('delete');
         })();)" :
@@ -35,7 +39,7 @@ void doCopy(CefRefPtr<CefBrowser> browser, bool cut) {
                 text = window.getSelection().toString();
             }
             if (text) {
-                window.jmpNative?.setClipboard?.('text/plain', btoa(text));
+                window.jmpNative?.setClipboard?.('text/plain', text);
             }
         })();)";
     frame->ExecuteJavaScript(js, "", 0);
@@ -46,35 +50,8 @@ void doPaste(CefRefPtr<CefBrowser> browser, const char* mimeType, const void* da
     auto frame = browser->GetFocusedFrame();
     if (!frame) frame = browser->GetMainFrame();
     if (!frame) return;
-    std::string b64Data = CefBase64Encode(data, len).ToString();
-    std::string b64Mime = CefBase64Encode(mimeType, strlen(mimeType)).ToString();
-
-    std::string js = R"((function() {
-        const b64 = ')" + b64Data + R"(';
-        const mime = atob(')" + b64Mime + R"(');
-        const binary = atob(b64);
-        const bytes = new Uint8Array(binary.length);
-        for (let i = 0; i < binary.length; i++) bytes[i] = binary.charCodeAt(i);
-
-        // For text, use execCommand which works reliably in inputs
-        if (mime.startsWith('text/')) {
-            const text = new TextDecoder().decode(bytes);
-            document.execCommand('insertText', false, text);
-            return;
-        }
-
-        // For binary (images etc), dispatch ClipboardEvent
-        const blob = new Blob([bytes], {type: mime});
-        const dt = new DataTransfer();
-        dt.items.add(new File([blob], 'paste', {type: mime}));
-        const event = new ClipboardEvent('paste', {
-            clipboardData: dt,
-            bubbles: true,
-            cancelable: true
-        });
-        document.activeElement.dispatchEvent(event);
-    })();)";
-    frame->ExecuteJavaScript(js, "", 0);
+    // Renderer hands the bytes to window._nativePaste as an ArrayBuffer
+    sendBlobMessage(frame, PID_RENDERER, "pasteData", mimeType, data, len);
 }
 
 struct ClipboardData {
@@ -100,25 +77,22 @@ void clipboardCleanup(void*) {
     g_clipboard.mimeType.clear();
 }
 
-bool handleSetClipboard(CefRefPtr<CefListValue> args) {
-    std::string mimeType = args->GetString(0).ToString();
-    std::string b64 = args->GetString(1).ToString();
-    CefRefPtr<CefBinaryValue> decoded = CefBase64Decode(b64);
-    if (!decoded) {
-        LOG_ERROR(LOG_CEF, "Clipboard base64 decode failed");
+bool handleSetClipboard(CefRefPtr<CefProcessMessage> message) {
+    BlobMessage blob;
+    if (!readBlobMessage(message, blob)) {
+        LOG_ERROR(LOG_CEF, "Malformed setClipboard message");
         return true;
     }
+    const std::string& mimeType = blob.header;
 
     if (mimeType.rfind("text/", 0) == 0) {
-        std::string text(decoded->GetSize(), '\0');
-        decoded->GetData(text.data(), text.size(), 0);
+        std::string text(reinterpret_cast<const char*>(blob.data), blob.size);
         SDL_SetClipboardText(text.c_str());
     } else {
         {
             std::lock_guard<std::mutex> lock(g_clipboard.mutex);
             g_clipboard.mimeType = mimeType;
-            g_clipboard.data.resize(decoded->GetSize());
-            decoded->GetData(g_clipboard.data.data(), g_clipboard.data.size(), 0);
+            g_clipboard.data.assign(blob.data, blob.data + blob.size);
         }
         const char* mimeTypes[] = { mimeType.c_str() };
         SDL_SetClipboardData(clipboardCallback, clipboardCleanup, nullptr, mimeTypes, 1);
@@ -129,63 +103,68 @@ bool handleSetClipboard(CefRefPtr<CefListValue> args) {
 void handleGetClipboard(CefRefPtr<CefBrowser> browser, CefRefPtr<CefListValue> args) {
     if (!browser) return;
     std::string mimeType = args->GetString(0).ToString();
-    std::string b64;
     size_t len = 0;
     void* data = SDL_GetClipboardData(mimeType.c_str(), &len);
-    if (data && len > 0) {
-        b64 = CefBase64Encode(data, len).ToString();
-        SDL_free(data);
-    }
-    CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("clipboardResult");
-    msg->GetArgumentList()->SetString(0, mimeType);
-    msg->GetArgumentList()->SetString(1, b64);
-    browser->GetMainFrame()->SendProcessMessage(PID_RENDERER, msg);
+    sendBlobMessage(browser->GetMainFrame(), PID_RENDERER, "clipboardResult", mimeType, data, data ? len : 0);
+    if (data) SDL_free(data);
 }
 } // namespace
 
-// URL request client for server connectivity checks
-class ConnectivityURLRequestClient : public CefURLRequestClient {
+// Stores fetched artwork on a CEF file thread, then hands the file:// URL to the player
+class ArtworkStoreTask : public CefTask {
 public:
-    ConnectivityURLRequestClient(CefRefPtr<CefBrowser> browser, const std::string& originalUrl)
-        : browser_(browser), original_url_(originalUrl) {}
+    ArtworkStoreTask(std::string url, std::string bytes, std::string mimeType, PlayerMessageCallback on_player_msg)
+        : url_(std::move(url)), bytes_(std::move(bytes)), mime_type_(std::move(mimeType)),
+          on_player_msg_(std::move(on_player_msg)) {}
+
+    void Execute() override {
+        auto& cache = ArtworkCache::instance();
+        std::string fileUrl = cache.store(url_, bytes_, mime_type_);
+        // Track may have changed while the fetch was in flight
+        if (fileUrl.empty() || !cache.isCurrent(url_)) return;
+        LOG_DEBUG(LOG_MEDIA, "Artwork cached: %s", fileUrl.c_str());
+        on_player_msg_("media_artwork", fileUrl, 0, "");
+    }
+
+private:
+    std::string url_;
+    std::string bytes_;
+    std::string mime_type_;
+    PlayerMessageCallback on_player_msg_;
+
+    IMPLEMENT_REFCOUNTING(ArtworkStoreTask);
+};
+
+// URL request client for media session artwork
+class ArtworkURLRequestClient : public CefURLRequestClient {
+public:
+    ArtworkURLRequestClient(const std::string& url, PlayerMessageCallback on_player_msg)
+        : url_(url), on_player_msg_(std::move(on_player_msg)) {}
 
     void OnRequestComplete(CefRefPtr<CefURLRequest> request) override {
         auto status = request->GetRequestStatus();
         auto response = request->GetResponse();
-
-        bool success = false;
-        std::string resolved_url = original_url_;
-
-        if (status == UR_SUCCESS && response && response->GetStatus() == 200) {
-            // Check if we got valid JSON with an "Id" field
-            if (response_body_.find("\"Id\"") != std::string::npos) {
-                success = true;
-                // Use the final URL after redirects
-                resolved_url = response->GetURL().ToString();
-                // Strip /System/Info/Public to get base URL
-                size_t pos = resolved_url.find("/System/Info/Public");
-                if (pos != std::string::npos) {
-                    resolved_url = resolved_url.substr(0, pos);
-                }
+        if (status != UR_SUCCESS || !response || response->GetStatus() != 200 || too_large_) {
+            if (status != UR_CANCELED) {
+                LOG_DEBUG(LOG_MEDIA, "Artwork fetch failed: %s (status %d)", url_.c_str(),
+                          response ? response->GetStatus() : 0);
             }
+            return;
         }
-
-        LOG_INFO(LOG_CEF, "Connectivity request complete: %s url=%s",
-                 success ? "success" : "failed", resolved_url.c_str());
-
-        // Send result back to renderer
-        CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("serverConnectivityResult");
-        msg->GetArgumentList()->SetString(0, original_url_);
-        msg->GetArgumentList()->SetBool(1, success);
-        msg->GetArgumentList()->SetString(2, resolved_url);
-        browser_->GetMainFrame()->SendProcessMessage(PID_RENDERER, msg);
+        CefPostTask(TID_FILE_USER_VISIBLE, new ArtworkStoreTask(url_, std::move(body_),
+            response->GetMimeType().ToString(), on_player_msg_));
     }
 
     void OnUploadProgress(CefRefPtr<CefURLRequest> request, int64_t current, int64_t total) override {}
     void OnDownloadProgress(CefRefPtr<CefURLRequest> request, int64_t current, int64_t total) override {}
 
     void OnDownloadData(CefRefPtr<CefURLRequest> request, const void* data, size_t data_length) override {
-        response_body_.append(static_cast<const char*>(data), data_length);
+        if (body_.size() + data_length > ArtworkCache::MAX_IMAGE_BYTES) {
+            too_large_ = true;
+            body_.clear();
+            return;
+        }
+        if (!too_large_) body_.append(static_cast<const char*>(data), data_length);
     }
 
     bool GetAuthCredentials(bool isProxy, const CefString& host, int port,
@@ -195,11 +174,12 @@ public:
     }
 
 private:
-    CefRefPtr<CefBrowser> browser_;
-    std::string original_url_;
-    std::string response_body_;
+    std::string url_;
+    PlayerMessageCallback on_player_msg_;
+    std::string body_;
+    bool too_large_ = false;
 
-    IMPLEMENT_REFCOUNTING(ConnectivityURLRequestClient);
+    IMPLEMENT_REFCOUNTING(ArtworkURLRequestClient);
 };
 
 Client::Client(int width, int height, PaintCallback on_paint, PlayerMessageCallback on_player_msg,
@@ -264,12 +244,16 @@ bool Client::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser,
         int audioIdx = args->GetSize() > 2 ? args->GetInt(2) : -1;
         int subIdx = args->GetSize() > 3 ? args->GetInt(3) : -1;
         std::string metadata = args->GetSize() > 4 ? args->GetString(4).ToString() : "{}";
-        // Encode track indices in metadata JSON
-        std::string prefix = "{";
-        if (audioIdx >= 0) prefix += "\"_audioIdx\":" + std::to_string(audioIdx) + ",";
-        if (subIdx >= 0) prefix += "\"_subIdx\":" + std::to_string(subIdx) + ",";
-        if (prefix.size() > 1 && metadata.size() > 1) {
-            metadata = prefix + metadata.substr(1);
+        // Encode track indices in metadata JSON (no trailing comma: the
+        // reader is strict, and the shim sends '{}' without item metadata)
+        std::string members;
+        if (audioIdx >= 0) members += "\"_audioIdx\":" + std::to_string(audioIdx);
+        if (subIdx >= 0) members += (members.empty() ? "\"_subIdx\":" : ",\"_subIdx\":") + std::to_string(subIdx);
+        size_t open = metadata.find_first_not_of(" \t\r\n");
+        if (!members.empty() && open != std::string::npos && metadata[open] == '{') {
+            size_t first = metadata.find_first_not_of(" \t\r\n", open + 1);
+            bool empty = first != std::string::npos && metadata[first] == '}';
+            metadata = "{" + members + (empty ? "" : ",") + metadata.substr(open + 1);
         }
         on_player_msg_("load", url, startMs, metadata);
         return true;
@@ -317,8 +301,11 @@ bool Client::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser,
         Settings::instance().saveAsync();
         return true;
     } else if (name == "notifyMetadata") {
-        std::string metadata = args->GetString(0).ToString();
-        on_player_msg_("media_metadata", metadata, 0, "");
+        BlobMessage blob;
+        if (readBlobMessage(message, blob)) {
+            std::string metadata(reinterpret_cast<const char*>(blob.data), blob.size);
+            on_player_msg_("media_metadata", metadata, 0, "");
+        }
         return true;
     } else if (name == "notifyPosition") {
         int posMs = args->GetInt(0);
@@ -333,8 +320,9 @@ bool Client::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser,
         on_player_msg_("media_state", state, 0, "");
         return true;
     } else if (name == "notifyArtwork") {
-        std::string artworkUri = args->GetString(0).ToString();
-        on_player_msg_("media_artwork", artworkUri, 0, "");
+        // Jellyfin image URL; fetched and cached natively, backends get a file:// URL
+        std::string url = args->GetString(0).ToString();
+        fetchArtwork(url);
         return true;
     } else if (name == "notifyQueueChange") {
         bool canNext = args->GetBool(0);
@@ -350,7 +338,7 @@ bool Client::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser,
         on_player_msg_("media_notify_rate", "", static_cast<int>(rate * 1000000), "");
         return true;
     } else if (name == "setClipboard") {
-        return handleSetClipboard(args);
+        return handleSetClipboard(message);
     } else if (name == "getClipboard") {
         handleGetClipboard(browser, args);
         return true;
@@ -399,6 +387,7 @@ void Client::OnPopupSize(CefRefPtr<CefBrowser> browser, const CefRect& rect) {
 void Client::OnPaint(CefRefPtr<CefBrowser> browser, PaintElementType type,
                      const RectList& dirtyRects, const void* buffer,
                      int width, int height) {
+    TRACE_SCOPE("OnPaint");
     static bool first = true;
     if (first) {
         LOG_INFO(LOG_CEF, "OnPaint: %dx%d type=%s", width, height,
@@ -465,6 +454,7 @@ void Client::OnPaint(CefRefPtr<CefBrowser> browser, PaintElementType type,
 void Client::OnAcceleratedPaint(CefRefPtr<CefBrowser> browser, PaintElementType type,
                                  const RectList& dirtyRects,
                                  const CefAcceleratedPaintInfo& info) {
+    TRACE_SCOPE("OnAcceleratedPaint");
 #ifdef __APPLE__
     static bool first = true;
     if (first) {
@@ -525,6 +515,19 @@ void Client::OnLoadEnd(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame,
     if (frame->IsMain()) {
         // Set focus after page load for proper visual focus on autofocus elements
         browser->GetHost()->SetFocus(true);
+        // Error pages also end here, with no HTTP status
+        if (httpStatusCode >= 200 && httpStatusCode < 400) startup_load_pending_ = false;
+    }
+}
+
+void Client::OnLoadError(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, ErrorCode errorCode,
+                         const CefString& errorText, const CefString& failedUrl) {
+    // ERR_ABORTED: navigation superseded or cancelled, not a failure
+    if (!frame->IsMain() || errorCode == ERR_ABORTED) return;
+    LOG_WARN(LOG_CEF, "Load failed: %s (%s, %d)", failedUrl.ToString().c_str(),
+             errorText.ToString().c_str(), errorCode);
+    if (on_player_msg_ && startup_load_pending_) {
+        on_player_msg_("loadError", failedUrl.ToString(), errorCode, "");
     }
 }
 
@@ -742,6 +745,36 @@ void Client::updateDuration(double durationMs) {
     executeJS("if(window._nativeUpdateDuration) window._nativeUpdateDuration(" + std::to_string(durationMs) + ");");
 }
 
+void Client::updateClock(double positionMs, double ageMs, double rate, bool paused) {
+    executeJS("if(window._nativeClockAnchor) window._nativeClockAnchor(" + std::to_string(positionMs) + "," +
+              std::to_string(ageMs) + "," + std::to_string(rate) + "," + (paused ? "true" : "false") + ");");
+}
+
+void Client::fetchArtwork(const std::string& url) {
+    if (artwork_request_) {
+        artwork_request_->Cancel();
+        artwork_request_ = nullptr;
+    }
+
+    auto& cache = ArtworkCache::instance();
+    std::string cached = cache.request(url);
+    if (url.empty()) return;
+    if (!cache.enabled()) {
+        // No cache directory: backends fall back to the remote URL
+        on_player_msg_("media_artwork", url, 0, "");
+        return;
+    }
+    if (!cached.empty()) {
+        on_player_msg_("media_artwork", cached, 0, "");
+        return;
+    }
+
+    CefRefPtr<CefRequest> request = CefRequest::Create();
+    request->SetURL(url);
+    request->SetMethod("GET");
+    artwork_request_ = CefURLRequest::Create(request, new ArtworkURLRequestClient(url, on_player_msg_), nullptr);
+}
+
 bool Client::RunContextMenu(CefRefPtr<CefBrowser> browser,
                             CefRefPtr<CefFrame> frame,
                             CefRefPtr<CefContextMenuParams> params,
@@ -830,32 +863,42 @@ bool OverlayClient::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser,
     }
 
     if (name == "checkServerConnectivity") {
-        std::string url = args->GetString(0).ToString();
-        LOG_INFO(LOG_CEF, "Overlay IPC checking connectivity: %s", url.c_str());
-
-        // Normalize URL
-        if (url.find("://") == std::string::npos) {
-            url = "http://" + url;
-        }
-        // Remove trailing slash
-        if (!url.empty() && url.back() == '/') {
-            url.pop_back();
+        // args: user input, optional explicit candidate list
+        std::string input = args->GetString(0).ToString();
+        std::vector<std::string> candidates;
+        if (args->GetSize() > 1 && args->GetType(1) == VTYPE_LIST) {
+            CefRefPtr<CefListValue> list = args->GetList(1);
+            for (size_t i = 0; i < list->GetSize(); i++) {
+                candidates.push_back(list->GetString(i).ToString());
+            }
+        } else {
+            candidates = ServerProbe::candidatesFor(input);
         }
+        LOG_INFO(LOG_CEF, "Overlay IPC checking connectivity: %s (%zu candidates)",
+                 input.c_str(), candidates.size());
+
+        if (server_probe_) server_probe_->cancel();
+        server_probe_ = ServerProbe::start(input, std::move(candidates),
+            [browser, input](bool success, const std::string& resolved_url) {
+                CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("serverConnectivityResult");
+                msg->GetArgumentList()->SetString(0, input);
+                msg->GetArgumentList()->SetBool(1, success);
+                msg->GetArgumentList()->SetString(2, resolved_url);
+                browser->GetMainFrame()->SendProcessMessage(PID_RENDERER, msg);
+            });
+        return true;
+    }
 
-        std::string check_url = url + "/System/Info/Public";
-
-        CefRefPtr<CefRequest> request = CefRequest::Create();
-        request->SetURL(check_url);
-        request->SetMethod("GET");
-
-        CefRefPtr<ConnectivityURLRequestClient> client =
-            new ConnectivityURLRequestClient(browser, url);
-        CefURLRequest::Create(request, client, nullptr);
+    if (name == "cancelServerConnectivity") {
+        if (server_probe_) {
+            server_probe_->cancel();
+            server_probe_ = nullptr;
+        }
         return true;
     }
 
     if (name == "setClipboard") {
-        return handleSetClipboard(args);
+        return handleSetClipboard(message);
     }
 
     if (name == "getClipboard") {
@@ -896,6 +939,7 @@ bool OverlayClient::GetScreenInfo(CefRefPtr<CefBrowser> browser, CefScreenInfo&
 void OverlayClient::OnPaint(CefRefPtr<CefBrowser> browser, PaintElementType type,
                              const RectList& dirtyRects, const void* buffer,
                              int width, int height) {
+    TRACE_SCOPE("Overlay OnPaint");
     static bool first = true;
     if (first) {
         LOG_INFO(LOG_CEF, "Overlay OnPaint: %dx%d", width, height);
@@ -909,6 +953,7 @@ void OverlayClient::OnPaint(CefRefPtr<CefBrowser> browser, PaintElementType type
 void OverlayClient::OnAcceleratedPaint(CefRefPtr<CefBrowser> browser, PaintElementType type,
                                         const RectList& dirtyRects,
                                         const CefAcceleratedPaintInfo& info) {
+    TRACE_SCOPE("Overlay OnAcceleratedPaint");
 #ifdef __APPLE__
     static bool first = true;
     if (first) {
@@ -955,6 +1000,10 @@ void OverlayClient::OnAfterCreated(CefRefPtr<CefBrowser> browser) {
 
 void OverlayClient::OnBeforeClose(CefRefPtr<CefBrowser> browser) {
     LOG_INFO(LOG_CEF, "Overlay browser closing");
+    if (server_probe_) {
+        server_probe_->cancel();
+        server_probe_ = nullptr;
+    }
     browser_ = nullptr;
     is_closed_ = true;
 }
@@ -5,6 +5,8 @@
 #include "include/cef_display_handler.h"
 #include "include/cef_load_handler.h"
 #include "include/cef_context_menu_handler.h"
+#include "include/cef_urlrequest.h"
+#include "cef/server_probe.h"
 #include <atomic>
 #include <functional>
 #include <vector>
@@ -112,6 +114,8 @@ public:
 
     // CefLoadHandler
     void OnLoadEnd(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, int httpStatusCode) override;
+    void OnLoadError(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, ErrorCode errorCode,
+                     const CefString& errorText, const CefString& failedUrl) override;
 
     // CefContextMenuHandler
     bool RunContextMenu(CefRefPtr<CefBrowser> browser,
@@ -121,6 +125,9 @@ public:
                         CefRefPtr<CefRunContextMenuCallback> callback) override;
 
     bool isClosed() const { return is_closed_; }
+    // True until the main frame first loads; only then can a load error mean
+    // the saved server is unreachable rather than a transient failure
+    bool startupLoadPending() const { return startup_load_pending_; }
     CefRefPtr<CefBrowser> browser() const { return browser_; }
 
     // Input forwarding (InputReceiver)
@@ -160,8 +167,13 @@ public:
     void emitRateChanged(double rate);
     void updatePosition(double positionMs);
     void updateDuration(double durationMs);
+    // Playback clock anchor: position sampled ageMs ago, advancing at rate unless paused
+    void updateClock(double positionMs, double ageMs, double rate, bool paused);
 
 private:
+    // Fetch media artwork into the artwork cache (cancels any fetch in flight)
+    void fetchArtwork(const std::string& url);
+
     int width_;
     int height_;
     PaintCallback on_paint_;
@@ -176,7 +188,9 @@ private:
     PhysicalSizeCallback physical_size_cb_;
     float scale_override_ = 0.0f;  // 0 = use physical/logical ratio
     std::atomic<bool> is_closed_ = false;
+    std::atomic<bool> startup_load_pending_ = true;
     CefRefPtr<CefBrowser> browser_;
+    CefRefPtr<CefURLRequest> artwork_request_;
 
     // Popup (dropdown) state
     bool popup_visible_ = false;
@@ -263,6 +277,7 @@ private:
     float scale_override_ = 0.0f;
     std::atomic<bool> is_closed_ = false;
     CefRefPtr<CefBrowser> browser_;
+    CefRefPtr<ServerProbe> server_probe_;  // UI thread
 
     IMPLEMENT_REFCOUNTING(OverlayClient);
     DISALLOW_COPY_AND_ASSIGN(OverlayClient);
@@ -1,6 +1,8 @@
 #include "cef_thread.h"
 #include "cef_app.h"
 #include "logging.h"
+#include "thread_policy.h"
+#include "trace.h"
 #include "include/cef_task.h"
 
 CefThread::~CefThread() {
@@ -41,6 +43,7 @@ void CefThread::shutdown() {
 }
 
 void CefThread::threadFunc(CefMainArgs args, CefSettings settings, CefRefPtr<CefApp> app) {
+    thread_policy::apply(thread_policy::Role::CefUi);
     LOG_INFO(LOG_CEF, "CEF thread starting");
 
     // Initialize CEF on this thread
@@ -0,0 +1,137 @@
+#include "cef/lz4_block.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t LAST_LITERALS = 5;   // block must end with at least 5 literals
+constexpr size_t MF_LIMIT = 12;       // no match may start within the last 12 bytes
+constexpr size_t MAX_OFFSET = 65535;
+constexpr int HASH_BITS = 16;
+
+uint32_t read32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint32_t hash4(uint32_t v) {
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Writes a length continuation (the part beyond the 4-bit token nibble)
+bool writeLength(uint8_t*& op, const uint8_t* oend, size_t len) {
+    while (len >= 255) {
+        if (op >= oend) return false;
+        *op++ = 255;
+        len -= 255;
+    }
+    if (op >= oend) return false;
+    *op++ = static_cast<uint8_t>(len);
+    return true;
+}
+
+bool emitSequence(uint8_t*& op, const uint8_t* oend, const uint8_t* lit, size_t lit_len,
+                  size_t offset, size_t match_len) {
+    if (op >= oend) return false;
+    uint8_t* token = op++;
+    *token = static_cast<uint8_t>((lit_len >= 15 ? 15 : lit_len) << 4);
+    if (lit_len >= 15 && !writeLength(op, oend, lit_len - 15)) return false;
+    if (static_cast<size_t>(oend - op) < lit_len) return false;
+    if (lit_len) memcpy(op, lit, lit_len);
+    op += lit_len;
+    if (match_len == 0) return true;  // final literal-only sequence
+
+    if (oend - op < 2) return false;
+    *op++ = static_cast<uint8_t>(offset & 0xff);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+    size_t ml = match_len - MIN_MATCH;
+    *token |= static_cast<uint8_t>(ml >= 15 ? 15 : ml);
+    if (ml >= 15 && !writeLength(op, oend, ml - 15)) return false;
+    return true;
+}
+
+bool readLength(const uint8_t*& ip, const uint8_t* iend, size_t& len) {
+    uint8_t b;
+    do {
+        if (ip >= iend) return false;
+        b = *ip++;
+        len += b;
+    } while (b == 255);
+    return true;
+}
+
+} // namespace
+
+size_t lz4Compress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_capacity) {
+    uint8_t* op = dst;
+    const uint8_t* oend = dst + dst_capacity;
+    const uint8_t* anchor = src;
+
+    if (src_size > MF_LIMIT) {
+        std::vector<uint32_t> table(size_t(1) << HASH_BITS, UINT32_MAX);
+        const uint8_t* match_limit = src + src_size - LAST_LITERALS;
+        size_t i = 0;
+        while (i + MF_LIMIT <= src_size) {
+            uint32_t seq = read32(src + i);
+            uint32_t h = hash4(seq);
+            uint32_t cand = table[h];
+            table[h] = static_cast<uint32_t>(i);
+            if (cand == UINT32_MAX || i - cand > MAX_OFFSET || read32(src + cand) != seq) {
+                i++;
+                continue;
+            }
+
+            // Extend forward, stopping before the mandatory trailing literals
+            const uint8_t* mp = src + i + MIN_MATCH;
+            const uint8_t* rp = src + cand + MIN_MATCH;
+            while (mp < match_limit && *mp == *rp) { mp++; rp++; }
+            size_t match_len = static_cast<size_t>(mp - (src + i));
+
+            if (!emitSequence(op, oend, anchor, static_cast<size_t>(src + i - anchor), i - cand, match_len))
+                return 0;
+            i += match_len;
+            anchor = src + i;
+        }
+    }
+
+    if (!emitSequence(op, oend, anchor, static_cast<size_t>(src + src_size - anchor), 0, 0))
+        return 0;
+    return static_cast<size_t>(op - dst);
+}
+
+bool lz4Decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) {
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + src_size;
+    uint8_t* op = dst;
+    uint8_t* oend = dst + dst_size;
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+
+        size_t lit_len = token >> 4;
+        if (lit_len == 15 && !readLength(ip, iend, lit_len)) return false;
+        if (static_cast<size_t>(iend - ip) < lit_len || static_cast<size_t>(oend - op) < lit_len) return false;
+        if (lit_len) memcpy(op, ip, lit_len);
+        ip += lit_len;
+        op += lit_len;
+        if (ip == iend) break;  // last sequence has no match
+
+        if (iend - ip < 2) return false;
+        size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+
+        size_t match_len = token & 15;
+        if (match_len == 15 && !readLength(ip, iend, match_len)) return false;
+        match_len += MIN_MATCH;
+        if (static_cast<size_t>(oend - op) < match_len) return false;
+
+        // Byte-wise: source and destination may overlap (offset < match_len)
+        const uint8_t* match = op - offset;
+        for (size_t k = 0; k < match_len; k++) op[k] = match[k];
+        op += match_len;
+    }
+    return op == oend;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Minimal LZ4 block format codec (no frame format, no dictionary).
+// Shared by the build-time resource packer and the runtime pack reader.
+
+// Worst-case compressed size for src_size input bytes
+constexpr size_t lz4CompressBound(size_t src_size) { return src_size + src_size / 255 + 16; }
+
+// Returns the compressed size, or 0 if the output would not fit in dst_capacity
+size_t lz4Compress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_capacity);
+
+// Returns false on malformed input or if the output is not exactly dst_size bytes
+bool lz4Decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size);
@@ -1,7 +1,60 @@
 #include "cef/resource_handler.h"
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <string_view>
 #include "logging.h"
 
+namespace {
+
+// Parses a single "bytes=first-last" range (RFC 9110), including the
+// open-ended "first-" and suffix "-length" forms. Returns false for absent,
+// multi-range or malformed headers, which are served as a full 200.
+bool parseRange(const std::string& header, size_t size, size_t& first, size_t& last, bool& satisfiable) {
+    constexpr std::string_view prefix = "bytes=";
+    if (header.compare(0, prefix.size(), prefix) != 0) return false;
+    std::string_view spec = std::string_view(header).substr(prefix.size());
+    if (spec.find(',') != std::string_view::npos) return false;
+    size_t dash = spec.find('-');
+    if (dash == std::string_view::npos) return false;
+
+    auto parseNum = [](std::string_view text, size_t& out) {
+        if (text.empty()) return false;
+        size_t v = 0;
+        for (char c : text) {
+            if (c < '0' || c > '9') return false;
+            v = v * 10 + static_cast<size_t>(c - '0');
+        }
+        out = v;
+        return true;
+    };
+
+    std::string_view a = spec.substr(0, dash);
+    std::string_view b = spec.substr(dash + 1);
+    size_t start = 0;
+    size_t end = 0;
+    if (a.empty()) {
+        // Suffix range: last N bytes
+        if (!parseNum(b, end)) return false;
+        satisfiable = end > 0 && size > 0;
+        first = end >= size ? 0 : size - end;
+        last = size - 1;
+        return true;
+    }
+    if (!parseNum(a, start)) return false;
+    if (b.empty()) {
+        end = size - 1;
+    } else if (!parseNum(b, end) || end < start) {
+        return false;
+    }
+    satisfiable = start < size;
+    first = start;
+    last = (std::min)(end, size - 1);
+    return true;
+}
+
+} // namespace
+
 CefRefPtr<CefResourceHandler> EmbeddedSchemeHandlerFactory::Create(
     CefRefPtr<CefBrowser> browser,
     CefRefPtr<CefFrame> frame,
@@ -11,49 +64,101 @@ CefRefPtr<CefResourceHandler> EmbeddedSchemeHandlerFactory::Create(
     std::string url = request->GetURL().ToString();
 
     // Strip scheme: "app://resources/foo.html" -> "resources/foo.html"
-    size_t pos = url.find("://");
-    if (pos != std::string::npos) {
-        url = url.substr(pos + 3);
+    std::string_view path = url;
+    size_t pos = path.find("://");
+    if (pos != std::string_view::npos) {
+        path.remove_prefix(pos + 3);
     }
 
-    auto it = embedded_resources.find(url);
-    if (it != embedded_resources.end()) {
-        return new EmbeddedResourceHandler(it->second);
+    ResourcePack::Data resource;
+    if (ResourcePack::instance().find(path, resource)) {
+        return new EmbeddedResourceHandler(std::move(resource));
     }
 
     LOG_WARN(LOG_RESOURCE, "EmbeddedScheme not found: %s", url.c_str());
     return nullptr;
 }
 
-EmbeddedResourceHandler::EmbeddedResourceHandler(const EmbeddedResource& resource)
-    : resource_(resource) {}
+EmbeddedResourceHandler::EmbeddedResourceHandler(ResourcePack::Data resource)
+    : resource_(std::move(resource)) {}
 
 bool EmbeddedResourceHandler::Open(CefRefPtr<CefRequest> request,
                                     bool& handle_request,
                                     CefRefPtr<CefCallback> callback) {
     handle_request = true;
+
+    char etag[24];
+    snprintf(etag, sizeof(etag), "\"%016llx\"", static_cast<unsigned long long>(resource_.hash));
+    etag_ = etag;
+
+    std::string if_none_match = request->GetHeaderByName("If-None-Match").ToString();
+    if (!if_none_match.empty() &&
+        (if_none_match == "*" || if_none_match.find(etag_) != std::string::npos)) {
+        status_ = 304;
+        end_ = 0;  // no body
+        return true;
+    }
+
+    end_ = resource_.size;
+    std::string range = request->GetHeaderByName("Range").ToString();
+    size_t first = 0;
+    size_t last = 0;
+    bool satisfiable = false;
+    if (!range.empty() && parseRange(range, resource_.size, first, last, satisfiable)) {
+        if (!satisfiable) {
+            status_ = 416;
+            end_ = 0;
+        } else {
+            status_ = 206;
+            offset_ = first;
+            end_ = last + 1;
+        }
+    }
     return true;
 }
 
 void EmbeddedResourceHandler::GetResponseHeaders(CefRefPtr<CefResponse> response,
                                                   int64_t& response_length,
                                                   CefString& redirect_url) {
-    response->SetStatus(200);
-    response->SetStatusText("OK");
-    response->SetMimeType(resource_.mime_type);
-    response_length = static_cast<int64_t>(resource_.size);
+    response->SetStatus(status_);
+    response->SetMimeType(std::string(resource_.mime_type));
+    // Content is fixed for the lifetime of the binary; ETag is its hash
+    response->SetHeaderByName("ETag", etag_, true);
+    response->SetHeaderByName("Cache-Control", "public, max-age=31536000, immutable", true);
+    response->SetHeaderByName("Accept-Ranges", "bytes", true);
+
+    switch (status_) {
+        case 206: {
+            response->SetStatusText("Partial Content");
+            response->SetHeaderByName("Content-Range",
+                "bytes " + std::to_string(offset_) + "-" + std::to_string(end_ - 1) + "/" +
+                std::to_string(resource_.size), true);
+            break;
+        }
+        case 304:
+            response->SetStatusText("Not Modified");
+            break;
+        case 416:
+            response->SetStatusText("Range Not Satisfiable");
+            response->SetHeaderByName("Content-Range", "bytes */" + std::to_string(resource_.size), true);
+            break;
+        default:
+            response->SetStatusText("OK");
+            break;
+    }
+    response_length = static_cast<int64_t>(end_ - offset_);
 }
 
 bool EmbeddedResourceHandler::Read(void* data_out,
                                    int bytes_to_read,
                                    int& bytes_read,
                                    CefRefPtr<CefResourceReadCallback> callback) {
-    if (offset_ >= resource_.size) {
+    if (offset_ >= end_) {
         bytes_read = 0;
         return false;
     }
 
-    size_t remaining = resource_.size - offset_;
+    size_t remaining = end_ - offset_;
     size_t to_copy = (std::min)(remaining, static_cast<size_t>(bytes_to_read));
     memcpy(data_out, resource_.data + offset_, to_copy);
     offset_ += to_copy;
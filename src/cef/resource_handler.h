@@ -2,7 +2,7 @@
 
 #include "include/cef_scheme.h"
 #include "include/cef_resource_handler.h"
-#include "embedded_resources.h"
+#include "cef/resource_pack.h"
 
 class EmbeddedSchemeHandlerFactory : public CefSchemeHandlerFactory {
 public:
@@ -17,7 +17,7 @@ public:
 
 class EmbeddedResourceHandler : public CefResourceHandler {
 public:
-    EmbeddedResourceHandler(const EmbeddedResource& resource);
+    explicit EmbeddedResourceHandler(ResourcePack::Data resource);
 
     bool Open(CefRefPtr<CefRequest> request,
               bool& handle_request,
@@ -35,8 +35,11 @@ public:
     void Cancel() override {}
 
 private:
-    const EmbeddedResource& resource_;
-    size_t offset_ = 0;
+    ResourcePack::Data resource_;
+    std::string etag_;
+    int status_ = 200;
+    size_t offset_ = 0;  // next byte to send
+    size_t end_ = 0;     // one past the last byte to send
 
     IMPLEMENT_REFCOUNTING(EmbeddedResourceHandler);
 };
@@ -0,0 +1,163 @@
+#include "cef/resource_pack.h"
+#include "cef/lz4_block.h"
+#include "logging.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace resource_pack;
+
+ResourcePack& ResourcePack::instance() {
+    static ResourcePack instance;
+    return instance;
+}
+
+ResourcePack::~ResourcePack() {
+    close();
+}
+
+void ResourcePack::close() {
+    if (!base_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(base_);
+    CloseHandle(static_cast<HANDLE>(mapping_));
+    CloseHandle(static_cast<HANDLE>(file_));
+    file_ = nullptr;
+    mapping_ = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(base_), size_);
+#endif
+    base_ = nullptr;
+    size_ = 0;
+    entries_ = nullptr;
+    count_ = 0;
+}
+
+bool ResourcePack::open(const std::string& path) {
+    if (base_) return true;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(sizeof(PackHeader))) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!base) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    file_ = file;
+    mapping_ = mapping;
+    size_t size = static_cast<size_t>(file_size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(PackHeader))) {
+        ::close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // mapping keeps the file referenced
+    if (base == MAP_FAILED) return false;
+#endif
+
+    base_ = static_cast<const uint8_t*>(base);
+    size_ = size;
+
+    const auto* header = reinterpret_cast<const PackHeader*>(base_);
+    if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+        sizeof(PackHeader) + static_cast<size_t>(header->count) * sizeof(PackEntry) > size_) {
+        LOG_ERROR(LOG_RESOURCE, "Invalid resource pack: %s", path.c_str());
+        close();
+        return false;
+    }
+    entries_ = reinterpret_cast<const PackEntry*>(base_ + sizeof(PackHeader));
+    count_ = header->count;
+
+    // Validate once so lookups can trust offsets
+    for (uint32_t i = 0; i < count_; i++) {
+        const PackEntry& e = entries_[i];
+        if (static_cast<uint64_t>(e.path_offset) + e.path_len > size_ ||
+            static_cast<uint64_t>(e.mime_offset) + e.mime_len > size_ ||
+            e.data_offset + e.stored_size > size_) {
+            LOG_ERROR(LOG_RESOURCE, "Corrupt resource pack entry %u: %s", i, path.c_str());
+            close();
+            return false;
+        }
+    }
+
+    LOG_INFO(LOG_RESOURCE, "Resource pack: %s (%u entries, %zu bytes)", path.c_str(), count_, size_);
+    return true;
+}
+
+std::string_view ResourcePack::str(uint32_t offset, uint16_t len) const {
+    return std::string_view(reinterpret_cast<const char*>(base_ + offset), len);
+}
+
+bool ResourcePack::find(std::string_view path, Data& out) {
+    if (!base_) return false;
+
+    const PackEntry* end = entries_ + count_;
+    const PackEntry* it = std::lower_bound(entries_, end, path,
+        [this](const PackEntry& e, std::string_view p) { return str(e.path_offset, e.path_len) < p; });
+    if (it == end || str(it->path_offset, it->path_len) != path) return false;
+
+    out.mime_type = str(it->mime_offset, it->mime_len);
+    out.size = it->size;
+    out.hash = it->hash;
+    const uint8_t* stored = base_ + it->data_offset;
+    if (!(it->flags & PACK_LZ4)) {
+        out.data = stored;
+        out.owner = nullptr;
+        return true;
+    }
+
+    uint32_t index = static_cast<uint32_t>(it - entries_);
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    for (auto slot = cache_.begin(); slot != cache_.end(); ++slot) {
+        if (slot->index == index) {
+            cache_.splice(cache_.begin(), cache_, slot);
+            out.owner = slot->bytes;
+            out.data = out.owner->data();
+            return true;
+        }
+    }
+
+    auto bytes = std::make_shared<std::vector<uint8_t>>(it->size);
+    if (!lz4Decompress(stored, it->stored_size, bytes->data(), bytes->size())) {
+        LOG_ERROR(LOG_RESOURCE, "Resource pack decompression failed: %.*s",
+                  static_cast<int>(path.size()), path.data());
+        return false;
+    }
+    out.owner = bytes;
+    out.data = bytes->data();
+
+    // Handlers keep their own reference, so eviction never frees in-flight data
+    cache_.push_front({index, std::move(bytes)});
+    cache_bytes_ += it->size;
+    while (cache_bytes_ > DECOMPRESSED_CACHE_BYTES && cache_.size() > 1) {
+        cache_bytes_ -= cache_.back().bytes->size();
+        cache_.pop_back();
+    }
+    return true;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Single-file pack of the app:// web resources, produced at build time by
+// cmake/pack_resources.cpp and mapped read-only at runtime.
+//
+// Layout (little-endian):
+//   PackHeader
+//   PackEntry[count]      sorted by path for binary search
+//   string table          paths and mime types, not NUL-terminated
+//   data                  per entry, LZ4 block compressed if PACK_LZ4 is set
+namespace resource_pack {
+
+constexpr char MAGIC[4] = {'J', 'D', 'R', 'P'};
+constexpr uint32_t VERSION = 2;
+constexpr uint32_t PACK_LZ4 = 1u << 0;
+
+struct PackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct PackEntry {
+    uint32_t path_offset;
+    uint16_t path_len;
+    uint16_t mime_len;
+    uint32_t mime_offset;
+    uint32_t flags;
+    uint64_t data_offset;
+    uint32_t stored_size;  // bytes in the pack
+    uint32_t size;         // bytes after decompression
+    uint64_t hash;         // FNV-1a 64 of the decompressed bytes, used as ETag
+};
+
+static_assert(sizeof(PackHeader) == 16, "PackHeader layout");
+static_assert(sizeof(PackEntry) == 40, "PackEntry layout");
+
+} // namespace resource_pack
+
+class ResourcePack {
+public:
+    // Resource bytes; either points into the mapping or is owned by a
+    // decompressed buffer shared with the LRU
+    struct Data {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        std::string_view mime_type;
+        uint64_t hash = 0;
+        std::shared_ptr<const std::vector<uint8_t>> owner;
+    };
+
+    static constexpr size_t DECOMPRESSED_CACHE_BYTES = 2 * 1024 * 1024;
+
+    static ResourcePack& instance();
+
+    bool open(const std::string& path);
+    bool isOpen() const { return base_ != nullptr; }
+
+    // path is relative to the scheme, e.g. "resources/index.html"
+    bool find(std::string_view path, Data& out);
+
+private:
+    ResourcePack() = default;
+    ~ResourcePack();
+    void close();
+    std::string_view str(uint32_t offset, uint16_t len) const;
+
+    const uint8_t* base_ = nullptr;
+    size_t size_ = 0;
+    const resource_pack::PackEntry* entries_ = nullptr;
+    uint32_t count_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+
+    // Small LRU of decompressed entries (front = most recent)
+    struct CacheSlot {
+        uint32_t index;
+        std::shared_ptr<const std::vector<uint8_t>> bytes;
+    };
+    std::mutex cache_mutex_;
+    std::list<CacheSlot> cache_;
+    size_t cache_bytes_ = 0;
+};
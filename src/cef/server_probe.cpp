@@ -0,0 +1,246 @@
+#include "cef/server_probe.h"
+#include "include/cef_task.h"
+#include "json_reader.h"
+#include "logging.h"
+#include <algorithm>
+#include <cctype>
+#include <unordered_map>
+
+namespace {
+
+constexpr const char* INFO_PATH = "/System/Info/Public";
+
+struct CachedResult {
+    std::string resolved_url;
+    std::chrono::steady_clock::time_point expires;
+};
+
+// UI thread only (see ServerProbe)
+std::unordered_map<std::string, CachedResult> g_cache;
+
+std::string normalizeInput(const std::string& input) {
+    size_t begin = 0, end = input.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(input[begin]))) begin++;
+    while (end > begin && std::isspace(static_cast<unsigned char>(input[end - 1]))) end--;
+    std::string out = input.substr(begin, end - begin);
+    while (!out.empty() && out.back() == '/') out.pop_back();
+    return out;
+}
+
+// A Jellyfin /System/Info/Public response: a JSON object with a non-empty Id
+bool isServerInfo(const std::string& body) {
+    JsonValue root = jsonParse(body);
+    bool has_id = false;
+    jsonForEachMember(root, [&](std::string_view key, const JsonValue& value) {
+        if (key == "Id" && value.type == JsonValue::Type::String && !value.raw.empty()) {
+            has_id = true;
+        }
+    });
+    return has_id;
+}
+
+} // namespace
+
+class ServerProbe::AttemptClient : public CefURLRequestClient {
+public:
+    AttemptClient(CefRefPtr<ServerProbe> probe, size_t index) : probe_(probe), index_(index) {}
+
+    void OnRequestComplete(CefRefPtr<CefURLRequest> request) override {
+        auto response = request->GetResponse();
+        bool success = request->GetRequestStatus() == UR_SUCCESS && response &&
+                       response->GetStatus() == 200 && !too_large_ && isServerInfo(body_);
+
+        std::string resolved_url;
+        if (success) {
+            // Final URL after redirects, minus the info path
+            resolved_url = response->GetURL().ToString();
+            size_t pos = resolved_url.find(INFO_PATH);
+            if (pos != std::string::npos) {
+                resolved_url.resize(pos);
+            }
+        }
+        LOG_DEBUG(LOG_CEF, "Connectivity attempt %s: %s", success ? "ok" : "failed",
+                  request->GetRequest()->GetURL().ToString().c_str());
+        probe_->onAttemptDone(index_, success, resolved_url);
+    }
+
+    void OnUploadProgress(CefRefPtr<CefURLRequest> request, int64_t current, int64_t total) override {}
+    void OnDownloadProgress(CefRefPtr<CefURLRequest> request, int64_t current, int64_t total) override {}
+
+    void OnDownloadData(CefRefPtr<CefURLRequest> request, const void* data, size_t data_length) override {
+        if (body_.size() + data_length > MAX_BODY_BYTES) {
+            too_large_ = true;
+            request->Cancel();
+            return;
+        }
+        body_.append(static_cast<const char*>(data), data_length);
+    }
+
+    bool GetAuthCredentials(bool isProxy, const CefString& host, int port,
+                            const CefString& realm, const CefString& scheme,
+                            CefRefPtr<CefAuthCallback> callback) override {
+        return false;
+    }
+
+private:
+    CefRefPtr<ServerProbe> probe_;
+    size_t index_;
+    std::string body_;
+    bool too_large_ = false;
+
+    IMPLEMENT_REFCOUNTING(AttemptClient);
+};
+
+class ServerProbe::DeadlineTask : public CefTask {
+public:
+    DeadlineTask(CefRefPtr<ServerProbe> probe, size_t index) : probe_(probe), index_(index) {}
+    void Execute() override { probe_->onAttemptTimeout(index_); }
+
+private:
+    CefRefPtr<ServerProbe> probe_;
+    size_t index_;
+
+    IMPLEMENT_REFCOUNTING(DeadlineTask);
+};
+
+class ServerProbe::GraceTask : public CefTask {
+public:
+    explicit GraceTask(CefRefPtr<ServerProbe> probe) : probe_(probe) {}
+    void Execute() override { probe_->onGrace(); }
+
+private:
+    CefRefPtr<ServerProbe> probe_;
+
+    IMPLEMENT_REFCOUNTING(GraceTask);
+};
+
+std::vector<std::string> ServerProbe::candidatesFor(const std::string& input) {
+    std::string address = normalizeInput(input);
+    if (address.empty()) return {};
+    if (address.find("://") != std::string::npos) return {address};
+
+    size_t slash = address.find('/');
+    std::string authority = address.substr(0, slash);
+    std::string path = slash == std::string::npos ? "" : address.substr(slash);
+
+    // Port present if there is a ':' after any IPv6 literal's closing bracket
+    size_t bracket = authority.rfind(']');
+    size_t colon = authority.rfind(':');
+    bool has_port = colon != std::string::npos && (bracket == std::string::npos || colon > bracket);
+    if (has_port) {
+        return {"http://" + address, "https://" + address};
+    }
+    return {
+        "https://" + address,
+        "http://" + address,
+        "http://" + authority + ":8096" + path,
+        "https://" + authority + ":8920" + path,
+    };
+}
+
+CefRefPtr<ServerProbe> ServerProbe::start(const std::string& input,
+                                          std::vector<std::string> candidates,
+                                          ResultCallback callback) {
+    std::string key = normalizeInput(input);
+    auto now = std::chrono::steady_clock::now();
+    auto cached = g_cache.find(key);
+    if (cached != g_cache.end()) {
+        if (cached->second.expires > now) {
+            LOG_INFO(LOG_CEF, "Connectivity cache hit: %s -> %s", key.c_str(),
+                     cached->second.resolved_url.c_str());
+            callback(true, cached->second.resolved_url);
+            return nullptr;
+        }
+        g_cache.erase(cached);
+    }
+
+    if (candidates.empty()) {
+        callback(false, std::string());
+        return nullptr;
+    }
+
+    CefRefPtr<ServerProbe> probe = new ServerProbe(key, std::move(callback));
+    // https candidates first, each group in candidate order
+    probe->attempts_.resize(candidates.size());
+    for (size_t i = 0; i < candidates.size(); i++) {
+        bool https = candidates[i].compare(0, 8, "https://") == 0;
+        probe->attempts_[i].base = candidates[i];
+        probe->attempts_[i].rank = (https ? 0 : candidates.size()) + i;
+    }
+    for (size_t i = 0; i < candidates.size(); i++) {
+        LOG_DEBUG(LOG_CEF, "Connectivity attempt: %s", candidates[i].c_str());
+        CefRefPtr<CefRequest> request = CefRequest::Create();
+        request->SetURL(candidates[i] + INFO_PATH);
+        request->SetMethod("GET");
+        request->SetFlags(UR_FLAG_DISABLE_CACHE);
+        probe->attempts_[i].request = CefURLRequest::Create(request, new AttemptClient(probe, i), nullptr);
+        CefPostDelayedTask(TID_UI, new DeadlineTask(probe, i), ATTEMPT_TIMEOUT_MS);
+    }
+    return probe;
+}
+
+void ServerProbe::cancel() {
+    if (done_) return;
+    done_ = true;
+    callback_ = nullptr;
+    for (auto& attempt : attempts_) {
+        if (attempt.pending && attempt.request) attempt.request->Cancel();
+        attempt.request = nullptr;
+    }
+}
+
+void ServerProbe::onAttemptDone(size_t index, bool success, const std::string& resolvedUrl) {
+    // Also ignores the cancelled completion of a timed-out attempt
+    if (done_ || !attempts_[index].pending) return;
+    attempts_[index].pending = false;
+    if (success && (best_ == SIZE_MAX || attempts_[index].rank < attempts_[best_].rank)) {
+        best_ = index;
+        best_url_ = resolvedUrl;
+    }
+    settle();
+}
+
+void ServerProbe::onAttemptTimeout(size_t index) {
+    if (done_ || !attempts_[index].pending) return;
+    LOG_INFO(LOG_CEF, "Connectivity attempt timed out: %s", attempts_[index].base.c_str());
+    attempts_[index].pending = false;
+    attempts_[index].request->Cancel();
+    settle();
+}
+
+void ServerProbe::onGrace() {
+    if (done_ || best_ == SIZE_MAX) return;
+    LOG_DEBUG(LOG_CEF, "Connectivity: no better answer within grace, using %s", best_url_.c_str());
+    finish(true, best_url_);
+}
+
+void ServerProbe::settle() {
+    bool better_pending = false;
+    bool any_pending = false;
+    for (const auto& attempt : attempts_) {
+        if (!attempt.pending) continue;
+        any_pending = true;
+        if (best_ == SIZE_MAX || attempt.rank < attempts_[best_].rank) better_pending = true;
+    }
+    if (best_ != SIZE_MAX && !better_pending) {
+        finish(true, best_url_);
+    } else if (best_ == SIZE_MAX && !any_pending) {
+        finish(false, std::string());
+    } else if (best_ != SIZE_MAX && !grace_posted_) {
+        // Only a preferred (https) candidate can still win; don't wait out its full timeout
+        grace_posted_ = true;
+        CefPostDelayedTask(TID_UI, new GraceTask(this), HTTPS_GRACE_MS);
+    }
+}
+
+void ServerProbe::finish(bool success, const std::string& resolvedUrl) {
+    ResultCallback callback = std::move(callback_);
+    // Cancel the losers (their completions are ignored once done_ is set)
+    cancel();
+    if (success) {
+        g_cache[key_] = {resolvedUrl, std::chrono::steady_clock::now() + CACHE_TTL};
+    }
+    LOG_INFO(LOG_CEF, "Connectivity check %s: %s -> %s", success ? "succeeded" : "failed",
+             key_.c_str(), resolvedUrl.c_str());
+    if (callback) callback(success, resolvedUrl);
+}
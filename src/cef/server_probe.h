@@ -0,0 +1,70 @@
+#pragma once
+
+#include "include/cef_base.h"
+#include "include/cef_urlrequest.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Races GET /System/Info/Public against every candidate URL for a server
+// address and reports the best one that answers as a Jellyfin server,
+// cancelling the rest. https outranks http: plain http usually answers first
+// (no TLS handshake), so after an http success a pending https candidate gets
+// HTTPS_GRACE_MS to answer too. Each candidate has its own ATTEMPT_TIMEOUT_MS.
+// Successful resolutions are cached for CACHE_TTL.
+// Browser UI thread only: request callbacks and the delayed tasks run there.
+class ServerProbe : public CefBaseRefCounted {
+public:
+    using ResultCallback = std::function<void(bool success, const std::string& resolvedUrl)>;
+
+    static constexpr int ATTEMPT_TIMEOUT_MS = 5000;
+    static constexpr int HTTPS_GRACE_MS = 1000;
+    static constexpr std::chrono::minutes CACHE_TTL{10};
+    static constexpr size_t MAX_BODY_BYTES = 64 * 1024;
+
+    // Candidates for user input: the input itself if it has a scheme,
+    // otherwise https/http plus Jellyfin's default ports for a bare host
+    static std::vector<std::string> candidatesFor(const std::string& input);
+
+    // Starts probing; returns nullptr if answered from cache (callback has run)
+    static CefRefPtr<ServerProbe> start(const std::string& input,
+                                        std::vector<std::string> candidates,
+                                        ResultCallback callback);
+
+    // Cancel outstanding requests; the callback will not run
+    void cancel();
+
+private:
+    class AttemptClient;
+    class DeadlineTask;
+    class GraceTask;
+
+    struct Attempt {
+        std::string base;
+        size_t rank = 0;  // lower is preferred
+        CefRefPtr<CefURLRequest> request;
+        bool pending = true;
+    };
+
+    ServerProbe(const std::string& key, ResultCallback callback)
+        : key_(key), callback_(std::move(callback)) {}
+
+    void onAttemptDone(size_t index, bool success, const std::string& resolvedUrl);
+    void onAttemptTimeout(size_t index);
+    void onGrace();
+    // Finish once the best success so far can no longer be beaten
+    void settle();
+    void finish(bool success, const std::string& resolvedUrl);
+
+    std::string key_;
+    ResultCallback callback_;
+    std::vector<Attempt> attempts_;
+    size_t best_ = SIZE_MAX;  // index of the best-ranked success so far
+    std::string best_url_;
+    bool grace_posted_ = false;
+    bool done_ = false;
+
+    IMPLEMENT_REFCOUNTING(ServerProbe);
+};
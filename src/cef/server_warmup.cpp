@@ -0,0 +1,196 @@
+#include "cef/server_warmup.h"
+#include "include/cef_parser.h"
+#include "include/cef_task.h"
+#include "include/cef_urlrequest.h"
+#include "logging.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <vector>
+
+namespace server_warmup {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Value of attribute `name` within one tag; offsets index both the
+// lowercased tag (for matching) and the original (for the value)
+std::string attribute(const std::string& tag, const std::string& lower, const char* name) {
+    std::string key = std::string(name) + "=";
+    for (size_t pos = lower.find(key); pos != std::string::npos; pos = lower.find(key, pos + 1)) {
+        if (pos == 0 || !std::isspace(static_cast<unsigned char>(lower[pos - 1]))) continue;
+        size_t start = pos + key.size();
+        if (start >= tag.size()) return {};
+        char quote = tag[start];
+        if (quote == '"' || quote == '\'') {
+            size_t end = tag.find(quote, start + 1);
+            return end == std::string::npos ? std::string() : tag.substr(start + 1, end - start - 1);
+        }
+        size_t end = start;
+        while (end < tag.size() && !std::isspace(static_cast<unsigned char>(tag[end])) && tag[end] != '>') end++;
+        return tag.substr(start, end - start);
+    }
+    return {};
+}
+
+// Scripts, stylesheets and preloads referenced by the entry document
+std::vector<std::string> referencedAssets(const std::string& html, const std::string& base) {
+    std::string lower(html.size(), '\0');
+    std::transform(html.begin(), html.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    std::vector<std::string> assets;
+    for (size_t pos = lower.find('<'); pos != std::string::npos && assets.size() < MAX_ASSETS;
+         pos = lower.find('<', pos + 1)) {
+        bool script = lower.compare(pos, 7, "<script") == 0;
+        bool link = lower.compare(pos, 5, "<link") == 0;
+        if (!script && !link) continue;
+        size_t end = lower.find('>', pos);
+        if (end == std::string::npos) break;
+
+        std::string tag = html.substr(pos, end - pos);
+        std::string tag_lower = lower.substr(pos, end - pos);
+        std::string ref;
+        if (script) {
+            ref = attribute(tag, tag_lower, "src");
+        } else {
+            std::string rel = attribute(tag_lower, tag_lower, "rel");
+            if (rel.find("stylesheet") != std::string::npos || rel.find("preload") != std::string::npos) {
+                ref = attribute(tag, tag_lower, "href");
+            }
+        }
+
+        CefString resolved;
+        if (!ref.empty() && CefResolveURL(base, ref, resolved)) {
+            std::string url = resolved.ToString();
+            if ((url.rfind("http://", 0) == 0 || url.rfind("https://", 0) == 0) &&
+                std::find(assets.begin(), assets.end(), url) == assets.end()) {
+                assets.push_back(url);
+            }
+        }
+        pos = end;
+    }
+    return assets;
+}
+
+class Warmup;
+
+// Downloads into the HTTP cache; the bytes themselves are discarded
+class AssetClient : public CefURLRequestClient {
+public:
+    explicit AssetClient(CefRefPtr<Warmup> warmup) : warmup_(warmup) {}
+
+    void OnRequestComplete(CefRefPtr<CefURLRequest> request) override;
+    void OnUploadProgress(CefRefPtr<CefURLRequest> request, int64_t current, int64_t total) override {}
+    void OnDownloadProgress(CefRefPtr<CefURLRequest> request, int64_t current, int64_t total) override {}
+    void OnDownloadData(CefRefPtr<CefURLRequest> request, const void* data, size_t data_length) override {}
+    bool GetAuthCredentials(bool isProxy, const CefString& host, int port,
+                            const CefString& realm, const CefString& scheme,
+                            CefRefPtr<CefAuthCallback> callback) override {
+        return false;
+    }
+
+private:
+    CefRefPtr<Warmup> warmup_;
+
+    IMPLEMENT_REFCOUNTING(AssetClient);
+};
+
+class Warmup : public CefURLRequestClient {
+public:
+    explicit Warmup(const std::string& url) : url_(url), start_(Clock::now()) {}
+
+    void begin() {
+        CefRefPtr<CefRequest> request = CefRequest::Create();
+        request->SetURL(url_);
+        request->SetMethod("GET");
+        CefURLRequest::Create(request, this, nullptr);
+    }
+
+    void OnRequestComplete(CefRefPtr<CefURLRequest> request) override {
+        auto response = request->GetResponse();
+        if (request->GetRequestStatus() != UR_SUCCESS || !response || response->GetStatus() != 200) {
+            LOG_DEBUG(LOG_CEF, "Warm-up: entry document failed (%s)", url_.c_str());
+            return;
+        }
+
+        // Relative references resolve against the final URL (after the
+        // server's redirect to /web/)
+        std::string base = response->GetURL().ToString();
+        std::vector<std::string> assets = referencedAssets(body_, base);
+        LOG_DEBUG(LOG_CEF, "Warm-up: %s loaded in %lld ms, prefetching %zu assets", base.c_str(),
+                  static_cast<long long>(elapsedMs()), assets.size());
+
+        pending_ = assets.size();
+        for (const auto& asset : assets) {
+            CefRefPtr<CefRequest> asset_request = CefRequest::Create();
+            asset_request->SetURL(asset);
+            asset_request->SetMethod("GET");
+            CefURLRequest::Create(asset_request, new AssetClient(this), nullptr);
+        }
+    }
+
+    void OnUploadProgress(CefRefPtr<CefURLRequest> request, int64_t current, int64_t total) override {}
+    void OnDownloadProgress(CefRefPtr<CefURLRequest> request, int64_t current, int64_t total) override {}
+
+    void OnDownloadData(CefRefPtr<CefURLRequest> request, const void* data, size_t data_length) override {
+        if (body_.size() + data_length > MAX_ENTRY_BYTES) {
+            request->Cancel();
+            return;
+        }
+        body_.append(static_cast<const char*>(data), data_length);
+    }
+
+    bool GetAuthCredentials(bool isProxy, const CefString& host, int port,
+                            const CefString& realm, const CefString& scheme,
+                            CefRefPtr<CefAuthCallback> callback) override {
+        return false;
+    }
+
+    void assetDone() {
+        if (pending_ > 0 && --pending_ == 0) {
+            LOG_INFO(LOG_CEF, "Warm-up complete in %lld ms", static_cast<long long>(elapsedMs()));
+        }
+    }
+
+private:
+    long long elapsedMs() const {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_).count();
+    }
+
+    std::string url_;
+    Clock::time_point start_;
+    std::string body_;
+    size_t pending_ = 0;
+
+    IMPLEMENT_REFCOUNTING(Warmup);
+};
+
+void AssetClient::OnRequestComplete(CefRefPtr<CefURLRequest> request) {
+    warmup_->assetDone();
+}
+
+class WarmupTask : public CefTask {
+public:
+    explicit WarmupTask(const std::string& url) : url_(url) {}
+    void Execute() override {
+        CefRefPtr<Warmup> warmup = new Warmup(url_);
+        warmup->begin();
+    }
+
+private:
+    std::string url_;
+
+    IMPLEMENT_REFCOUNTING(WarmupTask);
+};
+
+}  // namespace
+
+void start(const std::string& url) {
+    if (url.rfind("http://", 0) != 0 && url.rfind("https://", 0) != 0) return;
+    LOG_INFO(LOG_CEF, "Warm-up: %s", url.c_str());
+    CefPostTask(TID_UI, new WarmupTask(url));
+}
+
+}  // namespace server_warmup
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+// Warms the network path to the saved server while the rest of startup
+// runs. Fetching the entry document opens DNS/TCP/TLS to the origin; the
+// scripts and stylesheets it references are then fetched into the shared
+// HTTP cache, so the main browser's own navigation is served from there.
+namespace server_warmup {
+
+constexpr size_t MAX_ENTRY_BYTES = 2 * 1024 * 1024;
+constexpr size_t MAX_ASSETS = 16;
+
+// Any thread once CEF is initialized; requests run on the browser UI thread
+void start(const std::string& url);
+
+}  // namespace server_warmup
@@ -0,0 +1,124 @@
+#include "compositor/compositor_thread.h"
+#include "browser/browser_stack.h"
+#include "context/egl_context.h"
+#include "context/frame_context.h"
+#include "logging.h"
+#include "thread_policy.h"
+#include "trace.h"
+#include <future>
+
+CompositorThread::~CompositorThread() {
+    stop();
+}
+
+void CompositorThread::start(EGLContext_* egl, FrameContext* frame_context, BrowserStack* browsers,
+                             MenuCompositor* menu_compositor, MenuCompositor* hud_compositor) {
+    egl_ = egl;
+    frame_context_ = frame_context;
+    browsers_ = browsers;
+    menu_compositor_ = menu_compositor;
+    hud_compositor_ = hud_compositor;
+    reactor_.setWakeHandler([this]() { processMessages(); });
+
+    // A context can only be current on one thread at a time
+    egl_->releaseCurrent();
+    thread_ = std::thread(&CompositorThread::threadFunc, this);
+    LOG_INFO(LOG_COMPOSITOR, "compositor thread started");
+}
+
+void CompositorThread::stop() {
+    if (!running()) return;
+    post([this]() {
+        egl_->releaseCurrent();
+        reactor_.stop();
+    });
+    thread_.join();
+    egl_->makeCurrent();
+    LOG_INFO(LOG_COMPOSITOR, "compositor thread stopped");
+}
+
+void CompositorThread::post(std::function<void()> task) {
+    if (!running()) {
+        task();
+        return;
+    }
+    Message msg;
+    msg.task = std::move(task);
+    queue_.push(std::move(msg));
+    reactor_.wake();
+}
+
+void CompositorThread::runSync(const std::function<void()>& task) {
+    if (!running()) {
+        task();
+        return;
+    }
+    std::promise<void> done;
+    post([&]() {
+        task();
+        done.set_value();
+    });
+    done.get_future().wait();
+}
+
+void CompositorThread::submit(Frame frame) {
+    if (!running()) {
+        render(frame);
+        return;
+    }
+    Message msg;
+    msg.frame = std::move(frame);
+    queue_.push(std::move(msg));
+    reactor_.wake();
+}
+
+void CompositorThread::threadFunc() {
+    thread_policy::apply(thread_policy::Role::Compositor);
+    if (!egl_->makeCurrent()) return;
+    reactor_.run();
+}
+
+void CompositorThread::processMessages() {
+    batch_.clear();
+    queue_.drain(batch_);
+
+    Frame frame;
+    bool have_frame = false;
+    for (auto& msg : batch_) {
+        if (msg.task) {
+            // Keep submission order: a frame queued before the task is drawn
+            // first (only runs of consecutive frames coalesce)
+            if (have_frame) {
+                render(frame);
+                have_frame = false;
+            }
+            msg.task();
+            continue;
+        }
+        // A newer frame supersedes an older one, but layer pixels are only
+        // sent when they change, so an unsent upload carries forward
+        if (have_frame && msg.frame.menu.pixels.empty()) {
+            msg.frame.menu.pixels = std::move(frame.menu.pixels);
+        }
+        if (have_frame && msg.frame.hud.pixels.empty()) {
+            msg.frame.hud.pixels = std::move(frame.hud.pixels);
+        }
+        frame = std::move(msg.frame);
+        have_frame = true;
+    }
+    TRACE_COUNTER("compositor messages", batch_.size());
+    if (have_frame) render(frame);
+}
+
+void CompositorThread::render(const Frame& frame) {
+    TRACE_SCOPE("composite");
+    glViewport(0, 0, frame.viewport_width, frame.viewport_height);
+    frame_context_->beginFrame(frame.clear_color, frame.clear_alpha);
+
+    // Flush and composite all browsers (back-to-front order)
+    browsers_->renderAll(frame.viewport_width, frame.viewport_height, frame.stretch);
+    menu_compositor_->render(frame.menu, frame.viewport_width, frame.viewport_height);
+    hud_compositor_->render(frame.hud, frame.viewport_width, frame.viewport_height);
+
+    frame_context_->endFrame();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <functional>
+#include <thread>
+#include <vector>
+#include "compositor/menu_compositor.h"
+#include "player/lock_free.h"
+#include "player/reactor.h"
+
+class BrowserStack;
+class EGLContext_;
+class FrameContext;
+
+// Owns the EGL context once startup is done (Linux). Paint uploads, dmabuf
+// imports, compositing and the swap run here, so a large upload or a swap
+// blocked on vsync never delays input, CEF or player commands on the main
+// thread. The main thread talks to it only through queued messages:
+// frames (coalesced, latest wins) and GL tasks (run in order).
+class CompositorThread {
+public:
+    struct Frame {
+        int viewport_width = 0;
+        int viewport_height = 0;
+        float clear_color = 0.0f;
+        float clear_alpha = 1.0f;
+        bool stretch = false;  // live resize: browsers haven't repainted at this size
+        MenuCompositor::Layer menu;
+        MenuCompositor::Layer hud;
+    };
+
+    CompositorThread() = default;
+    ~CompositorThread();
+    CompositorThread(const CompositorThread&) = delete;
+    CompositorThread& operator=(const CompositorThread&) = delete;
+
+    // Main thread, with egl current: hand the context to the new thread
+    void start(EGLContext_* egl, FrameContext* frame_context, BrowserStack* browsers,
+               MenuCompositor* menu_compositor, MenuCompositor* hud_compositor);
+    // Main thread: finish queued work, then make egl current here again
+    void stop();
+    bool running() const { return thread_.joinable(); }
+
+    // Main thread: GL work (compositor creation, resize, removal), in order
+    // with frames. runSync waits for it; both run inline when not running.
+    void post(std::function<void()> task);
+    void runSync(const std::function<void()>& task);
+
+    // Main thread: replaces a frame the thread hasn't started yet, unless
+    // a task was posted after that frame (it is drawn before the task runs)
+    void submit(Frame frame);
+
+private:
+    struct Message {
+        std::function<void()> task;  // empty for a frame
+        Frame frame;
+    };
+
+    void threadFunc();
+    void processMessages();
+    void render(const Frame& frame);
+
+    EGLContext_* egl_ = nullptr;
+    FrameContext* frame_context_ = nullptr;
+    BrowserStack* browsers_ = nullptr;
+    MenuCompositor* menu_compositor_ = nullptr;
+    MenuCompositor* hud_compositor_ = nullptr;
+
+    std::thread thread_;
+    Reactor reactor_;
+    MpscQueue<Message> queue_;
+    std::vector<Message> batch_;  // compositor thread only
+};
@@ -0,0 +1,48 @@
+#include "compositor/menu_compositor.h"
+#include "logging.h"
+
+bool MenuCompositor::init(const CompositorContext& ctx) {
+    // Sized on first upload; starts as a 1x1 texture
+    compositor_ = std::make_unique<Compositor>();
+#ifdef __APPLE__
+    bool ok = compositor_->init(ctx.window, 1, 1);
+#else
+    bool ok = compositor_->init(ctx.gl_context, 1, 1);
+#endif
+    if (!ok) {
+        LOG_ERROR(LOG_MENU, "Menu compositor init failed");
+        compositor_.reset();
+        return false;
+    }
+    compositor_->setVisible(false);
+    return true;
+}
+
+void MenuCompositor::cleanup() {
+    if (compositor_) {
+        compositor_->cleanup();
+        compositor_.reset();
+    }
+}
+
+void MenuCompositor::render(const Layer& layer, int view_width, int view_height) {
+    if (!compositor_) return;
+
+    if (!layer.open) {
+        if (visible_) {
+            compositor_->setVisible(false);
+            visible_ = false;
+        }
+        return;
+    }
+
+    if (!layer.pixels.empty()) {
+        compositor_->updateOverlayPartial(layer.pixels.data(), layer.width, layer.height);
+    }
+    compositor_->setLayerRect(layer.x, layer.y, layer.width, layer.height);
+    if (!visible_) {
+        compositor_->setVisible(true);
+        visible_ = true;
+    }
+    compositor_->composite(view_width, view_height, 1.0f);
+}
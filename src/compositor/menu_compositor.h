@@ -0,0 +1,60 @@
+#pragma once
+
+#include "browser/browser_stack.h"
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Draws the context menu as its own layer above the browsers: a compositor
+// sized to the menu texture, placed with a layer rect. The texture is only
+// re-uploaded when the menu redraws, and browser frames are never touched.
+// The perf HUD uses a second instance.
+class MenuCompositor {
+public:
+    // The menu as of one frame, so it can be drawn away from the main thread
+    struct Layer {
+        bool open = false;
+        int x = 0, y = 0;  // view pixels
+        int width = 0, height = 0;
+        std::vector<uint8_t> pixels;  // BGRA; empty if unchanged since the last snapshot
+    };
+
+    bool init(const CompositorContext& ctx);
+    void cleanup();
+
+    // Main thread. scale maps the overlay's logical coordinates to view
+    // pixels. Overlay is MenuOverlay or PerfHud (same texture interface).
+    template <typename Overlay>
+    static Layer snapshot(Overlay& overlay, float scale);
+
+    // GL/Metal thread, after the browsers
+    void render(const Layer& layer, int view_width, int view_height);
+    template <typename Overlay>
+    void render(Overlay& overlay, float scale, int view_width, int view_height) {
+        render(snapshot(overlay, scale), view_width, view_height);
+    }
+
+private:
+    std::unique_ptr<Compositor> compositor_;
+    bool visible_ = false;
+};
+
+template <typename Overlay>
+MenuCompositor::Layer MenuCompositor::snapshot(Overlay& overlay, float scale) {
+    Layer layer;
+    if (!overlay.isOpen() || overlay.textureWidth() <= 0) return layer;
+
+    // Texture follows the view's pixel density
+    overlay.setScale(scale);
+    layer.open = true;
+    layer.x = static_cast<int>(std::lround(overlay.x() * scale));
+    layer.y = static_cast<int>(std::lround(overlay.y() * scale));
+    layer.width = overlay.textureWidth();
+    layer.height = overlay.textureHeight();
+    if (overlay.takePixelsDirty()) {
+        const uint8_t* pixels = overlay.pixels();
+        layer.pixels.assign(pixels, pixels + static_cast<size_t>(layer.width) * layer.height * 4);
+    }
+    return layer;
+}
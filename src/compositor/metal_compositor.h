@@ -44,6 +44,10 @@ public:
     // Resize
     void resize(uint32_t width, uint32_t height);
 
+    // Place the layer's view over a rect of the window (window pixels,
+    // top-left origin); w or h <= 0 restores the full-window view
+    void setLayerRect(int x, int y, int w, int h);
+
     // Visibility
     void setVisible(bool visible);
 
@@ -7,6 +7,7 @@
 #import <IOSurface/IOSurface.h>
 #include <cstring>
 #include "logging.h"
+#include "stats.h"
 
 // Helper macros for void* casts
 #define DEVICE ((__bridge id<MTLDevice>)device_)
@@ -279,6 +280,7 @@ void MetalCompositor::queueIOSurface(void* ioSurface, int format, int width, int
     }
 
     IOSurfaceRef surface = (IOSurfaceRef)ioSurface;
+    stats::add(stats::g_counters.cef_gpu_paints);
 
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -471,6 +473,35 @@ void MetalCompositor::setVisible(bool visible) {
     }
 }
 
+void MetalCompositor::setLayerRect(int x, int y, int w, int h) {
+    if (!metal_view_ || !parent_window_) {
+        return;
+    }
+
+    NSView* content_view = [parent_window_ contentView];
+    NSRect bounds = [content_view bounds];
+    NSRect frame = bounds;
+    if (w > 0 && h > 0) {
+        CGFloat scale = [parent_window_ backingScaleFactor];
+        frame = NSMakeRect(x / scale, y / scale, w / scale, h / scale);
+        if (![content_view isFlipped]) {
+            frame.origin.y = bounds.size.height - frame.origin.y - frame.size.height;
+        }
+    }
+    if (NSEqualRects([metal_view_ frame], frame)) {
+        return;
+    }
+
+    // A fixed rect must not follow window resizes
+    [metal_view_ setAutoresizingMask:(w > 0 && h > 0) ? NSViewNotSizable
+                                                       : (NSViewWidthSizable | NSViewHeightSizable)];
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    [metal_view_ setFrame:frame];
+    metal_layer_.frame = [metal_view_ bounds];
+    [CATransaction commit];
+}
+
 void MetalCompositor::resize(uint32_t width, uint32_t height) {
     if (width == width_ && height == height_) {
         return;
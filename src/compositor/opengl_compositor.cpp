@@ -1,8 +1,12 @@
 #include "compositor/opengl_compositor.h"
 #include <algorithm>
 #include <cstring>
+#include <string>
 #include <vector>
 #include "logging.h"
+#include "stats.h"
+#include "trace.h"
+#include "shader_cache.h"
 
 #if !defined(__APPLE__) && !defined(_WIN32)
 #include <drm_fourcc.h>  // For DRM_FORMAT_ARGB8888
@@ -45,8 +49,12 @@ static PFNGLUSEPROGRAMPROC glUseProgram = nullptr;
 static PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation = nullptr;
 static PFNGLUNIFORM1FPROC glUniform1f = nullptr;
 static PFNGLUNIFORM2FPROC glUniform2f = nullptr;
+static PFNGLUNIFORM4FPROC glUniform4f = nullptr;
 static PFNGLUNIFORM1IPROC glUniform1i = nullptr;
 static PFNGLACTIVETEXTUREPROC glActiveTexture = nullptr;
+static PFNGLPROGRAMPARAMETERIPROC glProgramParameteri = nullptr;
+static PFNGLGETPROGRAMBINARYPROC glGetProgramBinary = nullptr;
+static PFNGLPROGRAMBINARYPROC glProgramBinary = nullptr;
 
 static bool s_wglExtensionsLoaded = false;
 
@@ -77,8 +85,13 @@ static void loadWGLExtensions() {
     glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)wglGetProcAddress("glGetUniformLocation");
     glUniform1f = (PFNGLUNIFORM1FPROC)wglGetProcAddress("glUniform1f");
     glUniform2f = (PFNGLUNIFORM2FPROC)wglGetProcAddress("glUniform2f");
+    glUniform4f = (PFNGLUNIFORM4FPROC)wglGetProcAddress("glUniform4f");
     glUniform1i = (PFNGLUNIFORM1IPROC)wglGetProcAddress("glUniform1i");
     glActiveTexture = (PFNGLACTIVETEXTUREPROC)wglGetProcAddress("glActiveTexture");
+    // Optional (GL 4.1 / ARB_get_program_binary): null disables the program cache
+    glProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC)wglGetProcAddress("glProgramParameteri");
+    glGetProgramBinary = (PFNGLGETPROGRAMBINARYPROC)wglGetProcAddress("glGetProgramBinary");
+    glProgramBinary = (PFNGLPROGRAMBINARYPROC)wglGetProcAddress("glProgramBinary");
     s_wglExtensionsLoaded = true;
 }
 #endif
@@ -111,10 +124,14 @@ void main() {
 // Windows: Desktop OpenGL 2.1+ with GL_TEXTURE_2D
 static const char* vert_src = R"(#version 130
 out vec2 texCoord;
+uniform vec4 layerRect;  // x, y, w, h in view pixels, top-left origin
+uniform vec2 viewSize;
 void main() {
     vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
     texCoord = vec2(pos.x, 1.0 - pos.y);
-    gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+    // Map the unit square onto the layer rect (GL origin is bottom-left)
+    vec2 origin = vec2(layerRect.x, viewSize.y - layerRect.y - layerRect.w);
+    gl_Position = vec4((origin + pos * layerRect.zw) / viewSize * 2.0 - 1.0, 0.0, 1.0);
 }
 )";
 
@@ -124,6 +141,10 @@ out vec4 fragColor;
 uniform sampler2D overlayTex;
 uniform float alpha;
 void main() {
+    // The triangle overhangs the layer rect; nothing to draw there
+    if (texCoord.x > 1.0 || texCoord.y < 0.0) {
+        discard;
+    }
     vec4 color = texture(overlayTex, texCoord);
     // CEF provides BGRA - swizzle to RGBA
     fragColor = color.bgra * alpha;
@@ -131,7 +152,8 @@ void main() {
 )";
 #else
 // Linux: OpenGL ES 3.0
-// Render CEF texture at 1:1 pixels using gl_FragCoord
+// Render CEF texture at 1:1 pixels using gl_FragCoord; a layer rect of another
+// size (live resize stretch) samples it with linear filtering instead
 static const char* vert_src = R"(#version 300 es
 void main() {
     // Fullscreen triangle
@@ -146,19 +168,24 @@ out vec4 fragColor;
 uniform sampler2D overlayTex;
 uniform float alpha;
 uniform float swizzleBgra;
-uniform vec2 texSize;
-uniform vec2 viewSize;
+uniform highp vec2 texSize;
+uniform highp vec2 viewSize;
+uniform highp vec4 layerRect;  // x, y, w, h in view pixels, top-left origin
 void main() {
-    int px = int(gl_FragCoord.x);
-    // Flip Y using viewport height so texture anchors to TOP
-    int tex_y = int(viewSize.y) - 1 - int(gl_FragCoord.y);
+    // Flip Y using viewport height so texture anchors to TOP of the layer
+    highp vec2 pos = vec2(gl_FragCoord.x, viewSize.y - gl_FragCoord.y) - layerRect.xy;
 
     // Out of bounds = transparent (let background show through)
-    if (px < 0 || tex_y < 0 || px >= int(texSize.x) || tex_y >= int(texSize.y)) {
+    if (pos.x < 0.0 || pos.y < 0.0 || pos.x >= layerRect.z || pos.y >= layerRect.w) {
         discard;
     }
 
-    vec4 color = texelFetch(overlayTex, ivec2(px, tex_y), 0);
+    vec4 color;
+    if (layerRect.zw == texSize) {
+        color = texelFetch(overlayTex, ivec2(pos), 0);
+    } else {
+        color = texture(overlayTex, pos / layerRect.zw);
+    }
     // Software path provides BGRA, dmabuf provides RGBA (driver converts)
     if (swizzleBgra > 0.5) {
         color = color.bgra;
@@ -210,6 +237,7 @@ bool OpenGLCompositor::init(GLContext* ctx, uint32_t width, uint32_t height) {
 #endif
 
     if (!createTexture()) return false;
+    updateTextureBytes();
     if (!createShader()) return false;
 
     // Create VAO (required for GLES 3.0 / OpenGL core)
@@ -280,7 +308,84 @@ bool OpenGLCompositor::createTexture() {
     return true;
 }
 
+// Program binaries: core in GLES 3.0 (Linux), optional on Windows, and not
+// offered by the macOS 3.2 core profile
+static bool programBinarySupported() {
+#ifdef __APPLE__
+    return false;
+#else
+#ifdef _WIN32
+    if (!glProgramParameteri || !glGetProgramBinary || !glProgramBinary) return false;
+#endif
+    if (!ShaderCache::instance().enabled()) return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+#endif
+}
+
+// Driver identity + shader source, so a driver update or shader edit misses
+static uint64_t programCacheKey() {
+    std::string id;
+    for (GLenum e : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+        const GLubyte* s = glGetString(e);
+        id += s ? reinterpret_cast<const char*>(s) : "";
+        id += '\n';
+    }
+    id += vert_src;
+    id += frag_src;
+    return ShaderCache::hash(id);
+}
+
+bool OpenGLCompositor::loadProgramBinary(uint64_t key) {
+#ifndef __APPLE__
+    uint32_t format;
+    std::vector<uint8_t> blob;
+    if (!ShaderCache::instance().load("compositor", key, format, blob)) return false;
+
+    program_ = glCreateProgram();
+    glProgramBinary(program_, format, blob.data(), static_cast<GLsizei>(blob.size()));
+    GLint status = 0;
+    glGetProgramiv(program_, GL_LINK_STATUS, &status);
+    if (status) return true;
+
+    // Driver rejected it (e.g. updated without a version string change)
+    LOG_DEBUG(LOG_COMPOSITOR, "Cached program binary rejected, recompiling");
+    glDeleteProgram(program_);
+    program_ = 0;
+#else
+    (void)key;
+#endif
+    return false;
+}
+
+void OpenGLCompositor::storeProgramBinary(uint64_t key) {
+#ifndef __APPLE__
+    GLint length = 0;
+    glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<uint8_t> blob(length);
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program_, length, &written, &format, blob.data());
+    if (written <= 0) return;
+    blob.resize(written);
+    ShaderCache::instance().store("compositor", key, format, blob);
+#else
+    (void)key;
+#endif
+}
+
 bool OpenGLCompositor::createShader() {
+    bool use_cache = programBinarySupported();
+    uint64_t cache_key = use_cache ? programCacheKey() : 0;
+    if (use_cache && loadProgramBinary(cache_key)) {
+        LOG_DEBUG(LOG_COMPOSITOR, "Loaded compositor program from cache");
+        initUniforms();
+        return true;
+    }
+
     // Compile vertex shader
     GLuint vert = glCreateShader(GL_VERTEX_SHADER);
     glShaderSource(vert, 1, &vert_src, nullptr);
@@ -315,6 +420,9 @@ bool OpenGLCompositor::createShader() {
     program_ = glCreateProgram();
     glAttachShader(program_, vert);
     glAttachShader(program_, frag);
+#ifndef __APPLE__
+    if (use_cache) glProgramParameteri(program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
     glLinkProgram(program_);
 
     glGetProgramiv(program_, GL_LINK_STATUS, &status);
@@ -332,17 +440,22 @@ bool OpenGLCompositor::createShader() {
     glDeleteShader(vert);
     glDeleteShader(frag);
 
-    // Get uniform locations
+    if (use_cache) storeProgramBinary(cache_key);
+    initUniforms();
+    return true;
+}
+
+void OpenGLCompositor::initUniforms() {
     alpha_loc_ = glGetUniformLocation(program_, "alpha");
     swizzle_loc_ = glGetUniformLocation(program_, "swizzleBgra");
     tex_size_loc_ = glGetUniformLocation(program_, "texSize");
     view_size_loc_ = glGetUniformLocation(program_, "viewSize");
+    layer_rect_loc_ = glGetUniformLocation(program_, "layerRect");
     sampler_loc_ = glGetUniformLocation(program_, "overlayTex");
-
-    return true;
 }
 
 void OpenGLCompositor::updateOverlay(const void* data, int width, int height) {
+    TRACE_SCOPE("updateOverlay");
     std::lock_guard<std::mutex> lock(mutex_);
 
     if (width != static_cast<int>(width_) || height != static_cast<int>(height_)) {
@@ -352,6 +465,7 @@ void OpenGLCompositor::updateOverlay(const void* data, int width, int height) {
     if (pbo_mapped_) {
         std::memcpy(pbo_mapped_, data, width * height * 4);
         staging_pending_ = true;
+        beginPaintFlow();
     }
 }
 
@@ -362,6 +476,7 @@ void* OpenGLCompositor::getStagingBuffer(int width, int height) {
 }
 
 void OpenGLCompositor::updateOverlayPartial(const void* data, int src_width, int src_height) {
+    TRACE_SCOPE("updateOverlayPartial");
     std::lock_guard<std::mutex> lock(mutex_);
 
     if (!data || src_width <= 0 || src_height <= 0) return;
@@ -369,14 +484,15 @@ void OpenGLCompositor::updateOverlayPartial(const void* data, int src_width, int
     // Recreate CEF texture if size changed or texture doesn't exist
     if (cef_texture_ == 0 || src_width != cef_texture_width_ || src_height != cef_texture_height_) {
         LOG_DEBUG(LOG_COMPOSITOR, "updateOverlayPartial: RECREATE %dx%d -> %dx%d (viewport=%ux%u)",
-                  cef_texture_width_, cef_texture_height_, src_width, src_height, width_, height_);
+                  cef_texture_width_, cef_texture_height_, src_width, src_height, width_.load(), height_.load());
         if (cef_texture_) {
             glDeleteTextures(1, &cef_texture_);
         }
         glGenTextures(1, &cef_texture_);
         glBindTexture(GL_TEXTURE_2D, cef_texture_);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);  // No interpolation for 1:1
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        // 1:1 draws use texelFetch; filtering only applies when stretched
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         // Reset pixel unpack state before texture allocation
@@ -387,6 +503,7 @@ void OpenGLCompositor::updateOverlayPartial(const void* data, int src_width, int
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, src_width, src_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
         cef_texture_width_ = src_width;
         cef_texture_height_ = src_height;
+        updateTextureBytes();
         texture_valid_ = false;  // Need valid data before rendering
         LOG_DEBUG(LOG_COMPOSITOR, "Created CEF texture %dx%d", src_width, src_height);
     }
@@ -415,8 +532,10 @@ bool OpenGLCompositor::flushOverlay() {
     if (!staging_pending_ || !texture_) {
         return false;
     }
+    TRACE_SCOPE("flushOverlay");
+    endPaintFlow();
 
-    LOG_DEBUG(LOG_COMPOSITOR, "flushOverlay: uploading %ux%u", width_, height_);
+    LOG_DEBUG(LOG_COMPOSITOR, "flushOverlay: uploading %ux%u", width_.load(), height_.load());
 
     size_t pbo_size = width_ * height_ * 4;
 
@@ -441,6 +560,20 @@ bool OpenGLCompositor::flushOverlay() {
     return true;
 }
 
+// Trace arrow from the CEF paint that produced a frame to the
+// upload that consumed it; a superseded frame's flow is simply left open
+void OpenGLCompositor::beginPaintFlow() {
+    if (!trace::enabled()) return;
+    paint_flow_ = trace::newFlowId();
+    trace::flowBegin("paint", paint_flow_);
+}
+
+void OpenGLCompositor::endPaintFlow() {
+    if (!paint_flow_) return;
+    TRACE_FLOW_END("paint", paint_flow_);
+    paint_flow_ = 0;
+}
+
 void OpenGLCompositor::queueDmabuf(int fd, uint32_t stride, uint64_t modifier, int w, int h) {
 #if !defined(__APPLE__) && !defined(_WIN32)
     std::lock_guard<std::mutex> lock(mutex_);
@@ -456,6 +589,8 @@ void OpenGLCompositor::queueDmabuf(int fd, uint32_t stride, uint64_t modifier, i
     queued_dmabuf_.width = w;
     queued_dmabuf_.height = h;
     dmabuf_pending_.store(true, std::memory_order_release);
+    beginPaintFlow();
+    stats::add(stats::g_counters.cef_gpu_paints);
 #else
     (void)fd; (void)stride; (void)modifier; (void)w; (void)h;
 #endif
@@ -472,6 +607,8 @@ bool OpenGLCompositor::importQueuedDmabuf() {
         return false;
     }
 
+    TRACE_SCOPE("importQueuedDmabuf");
+
     // Get queued dmabuf under lock
     int fd;
     uint32_t stride;
@@ -489,6 +626,7 @@ bool OpenGLCompositor::importQueuedDmabuf() {
         h = queued_dmabuf_.height;
         dmabuf_pending_.store(false, std::memory_order_relaxed);
         queued_dmabuf_.fd = -1;
+        endPaintFlow();
     }
 
     if (fd < 0) {
@@ -588,6 +726,7 @@ void OpenGLCompositor::composite(uint32_t width, uint32_t height, float alpha) {
     if (!has_content_ || !program_) {
         return;
     }
+    TRACE_SCOPE("composite");
 
     glViewport(0, 0, width, height);
 
@@ -634,6 +773,10 @@ void OpenGLCompositor::composite(uint32_t width, uint32_t height, float alpha) {
         }
     }
     if (tex_size_loc_ >= 0) glUniform2f(tex_size_loc_, static_cast<float>(tex_w), static_cast<float>(tex_h));
+    // Default layer: the texture at 1:1, anchored top-left, or over the
+    // whole view while a resize waits for CEF to repaint
+    int default_w = stretch_ ? static_cast<int>(width) : tex_w;
+    int default_h = stretch_ ? static_cast<int>(height) : tex_h;
 #else
     // Windows/macOS: prefer cef_texture_ (from updateOverlayPartial) over legacy texture_
     if (cef_texture_) {
@@ -644,7 +787,17 @@ void OpenGLCompositor::composite(uint32_t width, uint32_t height, float alpha) {
         glBindTexture(GL_TEXTURE_2D, texture_);
         if (tex_size_loc_ >= 0) glUniform2f(tex_size_loc_, static_cast<float>(width_), static_cast<float>(height_));
     }
+    // Default layer: the texture stretched over the view
+    int default_w = static_cast<int>(width), default_h = static_cast<int>(height);
 #endif
+    if (layer_rect_loc_ >= 0) {
+        if (layer_w_ > 0 && layer_h_ > 0) {
+            glUniform4f(layer_rect_loc_, static_cast<float>(layer_x_), static_cast<float>(layer_y_),
+                        static_cast<float>(layer_w_), static_cast<float>(layer_h_));
+        } else {
+            glUniform4f(layer_rect_loc_, 0.0f, 0.0f, static_cast<float>(default_w), static_cast<float>(default_h));
+        }
+    }
 
     glBindVertexArray(vao_);
     glDrawArrays(GL_TRIANGLES, 0, 3);
@@ -653,9 +806,16 @@ void OpenGLCompositor::composite(uint32_t width, uint32_t height, float alpha) {
     glDisable(GL_BLEND);
 }
 
+void OpenGLCompositor::setLayerRect(int x, int y, int w, int h) {
+    layer_x_ = x;
+    layer_y_ = y;
+    layer_w_ = w;
+    layer_h_ = h;
+}
+
 void OpenGLCompositor::resize(uint32_t width, uint32_t height) {
     LOG_DEBUG(LOG_COMPOSITOR, "[%ldms] resize: viewport %ux%u -> %ux%u (CEF texture %dx%d)",
-              _comp_ms(), width_, height_, width, height, cef_texture_width_, cef_texture_height_);
+              _comp_ms(), width_.load(), height_.load(), width, height, cef_texture_width_, cef_texture_height_);
 
     if (width == 0 || height == 0 || (width == width_ && height == height_)) {
         return;
@@ -667,14 +827,44 @@ void OpenGLCompositor::resize(uint32_t width, uint32_t height) {
     width_ = width;
     height_ = height;
 
-    // Recreate legacy texture/PBOs at new size (needed for flushOverlay compatibility)
-    destroyTexture();
+    // Recreate legacy texture/PBOs at new size (needed for flushOverlay compatibility).
+    // The imported dmabuf stays: it is the last good frame until CEF repaints.
+    destroyStaging();
     if (!createTexture()) {
         LOG_ERROR(LOG_COMPOSITOR, "createTexture failed during resize");
     }
+    updateTextureBytes();
+}
+
+void OpenGLCompositor::updateTextureBytes() {
+    // CEF texture plus the legacy texture and its two PBOs; imported dmabufs
+    // are CEF's memory
+    int64_t bytes = static_cast<int64_t>(cef_texture_width_) * cef_texture_height_ * 4;
+    if (texture_) bytes += static_cast<int64_t>(width_) * height_ * 4 * 3;
+    stats::adjust(stats::g_counters.texture_bytes, bytes - texture_bytes_);
+    texture_bytes_ = bytes;
 }
 
 void OpenGLCompositor::destroyTexture() {
+    destroyStaging();
+
+#if !defined(__APPLE__) && !defined(_WIN32)
+    // Clean up dmabuf resources
+    if (egl_image_ && ctx_ && eglDestroyImageKHR) {
+        eglDestroyImageKHR(ctx_->display(), static_cast<EGLImageKHR>(egl_image_));
+        egl_image_ = nullptr;
+    }
+    if (dmabuf_texture_) {
+        glDeleteTextures(1, &dmabuf_texture_);
+        dmabuf_texture_ = 0;
+    }
+    use_dmabuf_ = false;
+    dmabuf_width_ = 0;
+    dmabuf_height_ = 0;
+#endif
+}
+
+void OpenGLCompositor::destroyStaging() {
     // Unmap and delete PBOs
     if (pbo_mapped_) {
         glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbos_[current_pbo_]);
@@ -691,21 +881,6 @@ void OpenGLCompositor::destroyTexture() {
         glDeleteTextures(1, &texture_);
         texture_ = 0;
     }
-
-#if !defined(__APPLE__) && !defined(_WIN32)
-    // Clean up dmabuf resources
-    if (egl_image_ && ctx_ && eglDestroyImageKHR) {
-        eglDestroyImageKHR(ctx_->display(), static_cast<EGLImageKHR>(egl_image_));
-        egl_image_ = nullptr;
-    }
-    if (dmabuf_texture_) {
-        glDeleteTextures(1, &dmabuf_texture_);
-        dmabuf_texture_ = 0;
-    }
-    use_dmabuf_ = false;
-    dmabuf_width_ = 0;
-    dmabuf_height_ = 0;
-#endif
 }
 
 void OpenGLCompositor::cleanup() {
@@ -720,6 +895,7 @@ void OpenGLCompositor::cleanup() {
         cef_texture_width_ = 0;
         cef_texture_height_ = 0;
     }
+    updateTextureBytes();
 
     if (program_) {
         glDeleteProgram(program_);
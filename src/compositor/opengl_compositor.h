@@ -38,9 +38,10 @@ public:
     // Update with partial/mismatched size data (copies overlapping region)
     void updateOverlayPartial(const void* data, int src_width, int src_height);
 
-    // Get current compositor dimensions
-    uint32_t width() const { return width_; }
-    uint32_t height() const { return height_; }
+    // Get current compositor dimensions (any thread; resize runs on the
+    // compositor thread)
+    uint32_t width() const { return width_.load(std::memory_order_relaxed); }
+    uint32_t height() const { return height_.load(std::memory_order_relaxed); }
 
     // Flush pending overlay data to GPU
     bool flushOverlay();
@@ -54,9 +55,18 @@ public:
     // Import queued dmabuf (must be called from main/GL thread)
     bool importQueuedDmabuf();
 
+    // Draw into a rect of the view (view pixels, top-left origin) instead
+    // of the default placement; w or h <= 0 restores the default
+    void setLayerRect(int x, int y, int w, int h);
+
     // Resize resources
     void resize(uint32_t width, uint32_t height);
 
+    // Linux: draw the default layer over the whole view instead of 1:1, so a
+    // frame painted at the old size fills the window during a live resize.
+    // Windows/macOS always stretch the default layer.
+    void setStretchToView(bool stretch) { stretch_ = stretch; }
+
     // Set visibility (no-op on Linux, alpha controls rendering)
     void setVisible(bool visible) { (void)visible; }
 
@@ -66,11 +76,18 @@ public:
 private:
     bool createTexture();
     bool createShader();
+    bool loadProgramBinary(uint64_t key);
+    void storeProgramBinary(uint64_t key);
+    void initUniforms();
     void destroyTexture();
+    void destroyStaging();  // legacy texture and PBOs only
+    void updateTextureBytes();  // report allocations to stats
+
+    int64_t texture_bytes_ = 0;  // last reported by updateTextureBytes
 
     GLContext* ctx_ = nullptr;
-    uint32_t width_ = 0;
-    uint32_t height_ = 0;
+    std::atomic<uint32_t> width_{0};
+    std::atomic<uint32_t> height_{0};
 
     // CEF texture - stores raw CEF frame at CEF's painted size (independent of viewport)
     GLuint cef_texture_ = 0;
@@ -84,7 +101,7 @@ private:
     GLuint pbos_[2] = {0, 0};
     int current_pbo_ = 0;
     void* pbo_mapped_ = nullptr;
-    bool staging_pending_ = false;
+    std::atomic<bool> staging_pending_{false};  // polled by the main thread
 
     // Thread safety
     std::mutex mutex_;
@@ -96,6 +113,14 @@ private:
     GLint tex_size_loc_ = -1;
     GLint view_size_loc_ = -1;
     GLint sampler_loc_ = -1;
+    GLint layer_rect_loc_ = -1;
+
+    // Layer rect (see setLayerRect); zero size = default placement
+    int layer_x_ = 0;
+    int layer_y_ = 0;
+    int layer_w_ = 0;
+    int layer_h_ = 0;
+    bool stretch_ = false;  // see setStretchToView
 
     // VAO for fullscreen quad
     GLuint vao_ = 0;
@@ -104,6 +129,11 @@ private:
     int texture_unit_ = 0;
     int log_count_ = 0;  // Per-instance log counter
 
+    // Trace flow id of the pending frame (guarded by mutex_)
+    uint64_t paint_flow_ = 0;
+    void beginPaintFlow();
+    void endPaintFlow();
+
 #if !defined(__APPLE__) && !defined(_WIN32)
     // Dmabuf import (Linux only)
     GLuint dmabuf_texture_ = 0;
@@ -216,6 +216,18 @@ void EGLContext_::swapBuffers() {
     eglSwapBuffers(display_, surface_);
 }
 
+bool EGLContext_::makeCurrent() {
+    if (!eglMakeCurrent(display_, surface_, surface_, context_)) {
+        LOG_ERROR(LOG_GL, "[EGL] Failed to make context current");
+        return false;
+    }
+    return true;
+}
+
+void EGLContext_::releaseCurrent() {
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
 bool EGLContext_::resize(int width, int height) {
     if (width == width_ && height == height_) {
         return true;
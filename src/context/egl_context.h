@@ -21,6 +21,10 @@ public:
     void swapBuffers();
     bool resize(int width, int height);
 
+    // Move the context between threads: release on the old one first
+    bool makeCurrent();
+    void releaseCurrent();
+
     EGLDisplay display() const { return display_; }
     EGLContext context() const { return context_; }
     int width() const { return width_; }
@@ -0,0 +1,288 @@
+#include "json_reader.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace json_detail {
+
+const char* skipWs(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+    return p;
+}
+
+static bool isHex(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+// p at opening quote; returns one past the closing quote. Rejects raw control
+// characters and unknown or short escapes.
+static const char* skipString(const char* p, const char* end) {
+    for (p++; p < end; p++) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"') return p + 1;
+        if (c < 0x20) return nullptr;
+        if (c != '\\') continue;
+        if (++p == end) return nullptr;
+        switch (*p) {
+        case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+            break;
+        case 'u':
+            if (end - p < 5 || !isHex(p[1]) || !isHex(p[2]) || !isHex(p[3]) || !isHex(p[4])) return nullptr;
+            p += 4;
+            break;
+        default:
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+static const char* skipLiteral(const char* p, const char* end, const char* lit) {
+    size_t len = strlen(lit);
+    if (static_cast<size_t>(end - p) < len || memcmp(p, lit, len) != 0) return nullptr;
+    return p + len;
+}
+
+static const char* skipDigits(const char* p, const char* end) {
+    const char* start = p;
+    while (p < end && *p >= '0' && *p <= '9') p++;
+    return p == start ? nullptr : p;
+}
+
+static const char* skipNumber(const char* p, const char* end) {
+    if (p < end && *p == '-') p++;
+    if (p < end && *p == '0') {
+        p++;  // No leading zeros
+    } else {
+        p = skipDigits(p, end);
+        if (!p) return nullptr;
+    }
+    if (p < end && *p == '.') {
+        p = skipDigits(p + 1, end);
+        if (!p) return nullptr;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        if (p < end && (*p == '+' || *p == '-')) p++;
+        p = skipDigits(p, end);
+    }
+    return p;
+}
+
+// Any value but an array or object; returns one past its end, or nullptr
+static const char* skipScalar(const char* p, const char* end, JsonValue::Type& type) {
+    switch (*p) {
+    case '"': type = JsonValue::Type::String; return skipString(p, end);
+    case 't': type = JsonValue::Type::Bool; return skipLiteral(p, end, "true");
+    case 'f': type = JsonValue::Type::Bool; return skipLiteral(p, end, "false");
+    case 'n': type = JsonValue::Type::Null; return skipLiteral(p, end, "null");
+    default:  type = JsonValue::Type::Number; return skipNumber(p, end);
+    }
+}
+
+// p at '{' or '['. Validates the grammar of the whole container (member
+// keys, ':' and ',' placement, scalars) without recursion: nesting is a bit
+// stack (1 = object), max depth 64.
+static const char* skipContainer(const char* p, const char* end) {
+    enum class Expect { ItemOrClose, Item, CommaOrClose };
+    uint64_t stack = 0;
+    int depth = 0;
+    Expect expect = Expect::Item;  // the container itself
+    while (true) {
+        p = skipWs(p, end);
+        if (p == end) return nullptr;
+        bool in_object = depth > 0 && (stack & 1);
+        char c = *p;
+
+        if (expect != Expect::Item && depth > 0 && c == (in_object ? '}' : ']')) {
+            stack >>= 1;
+            if (--depth == 0) return p + 1;
+            p++;
+            expect = Expect::CommaOrClose;
+            continue;
+        }
+        if (expect == Expect::CommaOrClose) {
+            if (c != ',') return nullptr;
+            p++;
+            expect = Expect::Item;
+            continue;
+        }
+
+        // An item: in objects a "key": prefix, then a value
+        if (in_object) {
+            if (c != '"') return nullptr;
+            p = skipString(p, end);
+            if (!p) return nullptr;
+            p = skipWs(p, end);
+            if (p == end || *p != ':') return nullptr;
+            p = skipWs(p + 1, end);
+            if (p == end) return nullptr;
+            c = *p;
+        }
+        if (c == '{' || c == '[') {
+            if (depth == 64) return nullptr;
+            stack = (stack << 1) | (c == '{' ? 1 : 0);
+            depth++;
+            p++;
+            expect = Expect::ItemOrClose;
+            continue;
+        }
+        if (depth == 0) return nullptr;  // not a container
+        JsonValue::Type type;
+        p = skipScalar(p, end, type);
+        if (!p) return nullptr;
+        expect = Expect::CommaOrClose;
+    }
+}
+
+const char* parseValue(const char* p, const char* end, JsonValue& out) {
+    p = skipWs(p, end);
+    if (p == end) return nullptr;
+    const char* start = p;
+    if (*p == '{' || *p == '[') {
+        out.type = *p == '{' ? JsonValue::Type::Object : JsonValue::Type::Array;
+        p = skipContainer(p, end);
+    } else {
+        p = skipScalar(p, end, out.type);
+    }
+    if (!p) {
+        out.type = JsonValue::Type::Invalid;
+        return nullptr;
+    }
+    if (out.type == JsonValue::Type::String) {
+        out.raw = std::string_view(start + 1, p - start - 2);
+    } else {
+        out.raw = std::string_view(start, p - start);
+    }
+    return p;
+}
+
+const char* enterContainer(const JsonValue& container, const char*& end) {
+    if (container.raw.size() < 2) return nullptr;
+    end = container.raw.data() + container.raw.size() - 1;
+    return skipWs(container.raw.data() + 1, end);
+}
+
+const char* nextItem(const char* p, const char* end, bool& done) {
+    p = skipWs(p, end);
+    if (p == end) {
+        done = true;
+        return p;
+    }
+    if (*p != ',') return nullptr;
+    p = skipWs(p + 1, end);
+    return p == end ? nullptr : p;  // Trailing comma
+}
+
+} // namespace json_detail
+
+JsonValue jsonParse(std::string_view json) {
+    const char* end = json.data() + json.size();
+    JsonValue value;
+    const char* p = json_detail::parseValue(json.data(), end, value);
+    if (!p || json_detail::skipWs(p, end) != end) return JsonValue{};
+    return value;
+}
+
+bool JsonValue::asBool(bool def) const {
+    if (type != Type::Bool) return def;
+    return raw == "true";
+}
+
+double JsonValue::asDouble(double def) const {
+    if (type != Type::Number || raw.size() >= 64) return def;
+    char buf[64];
+    memcpy(buf, raw.data(), raw.size());
+    buf[raw.size()] = '\0';
+    return std::strtod(buf, nullptr);
+}
+
+int64_t JsonValue::asInt(int64_t def) const {
+    if (type != Type::Number) return def;
+    // Fractions, exponents and anything past int64 range go through strtod
+    if (raw.size() > 18 || raw.find_first_of(".eE") != std::string_view::npos) {
+        double d = asDouble();
+        // Out-of-range (1e300) and NaN casts are undefined; 2^63 is exact
+        if (!(d >= -0x1p63 && d < 0x1p63)) return def;
+        return static_cast<int64_t>(d);
+    }
+    size_t i = 0;
+    bool negative = raw[0] == '-';
+    if (negative) i++;
+    int64_t val = 0;
+    for (; i < raw.size(); i++) val = val * 10 + (raw[i] - '0');
+    return negative ? -val : val;
+}
+
+static void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+static bool parseHex4(std::string_view s, size_t pos, uint32_t& out) {
+    if (pos + 4 > s.size()) return false;
+    out = 0;
+    for (size_t i = pos; i < pos + 4; i++) {
+        char c = s[i];
+        out <<= 4;
+        if (c >= '0' && c <= '9') out |= c - '0';
+        else if (c >= 'a' && c <= 'f') out |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') out |= c - 'A' + 10;
+        else return false;
+    }
+    return true;
+}
+
+std::string JsonValue::asString() const {
+    std::string out;
+    if (type != Type::String) return out;
+    out.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); i++) {
+        char c = raw[i];
+        if (c != '\\' || i + 1 >= raw.size()) {
+            out += c;
+            continue;
+        }
+        char e = raw[++i];
+        switch (e) {
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'n': out += '\n'; break;
+        case 'r': out += '\r'; break;
+        case 't': out += '\t'; break;
+        case 'u': {
+            // Malformed escapes and unpaired surrogates become U+FFFD
+            uint32_t cp;
+            if (!parseHex4(raw, i + 1, cp)) {
+                appendUtf8(out, 0xFFFD);
+                break;
+            }
+            i += 4;
+            uint32_t lo;
+            if (cp >= 0xD800 && cp < 0xDC00 && i + 2 < raw.size() && raw[i + 1] == '\\' &&
+                raw[i + 2] == 'u' && parseHex4(raw, i + 3, lo) && lo >= 0xDC00 && lo < 0xE000) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                i += 6;
+            } else if (cp >= 0xD800 && cp < 0xE000) {
+                cp = 0xFFFD;
+            }
+            appendUtf8(out, cp);
+            break;
+        }
+        default: out += e; break;  // \" \\ \/
+        }
+    }
+    return out;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Minimal single-pass JSON reader. Values are views into the source text; nothing
+// is allocated unless a string is copied out with asString(). Callers walk an
+// object once with jsonForEachMember and pick the keys they care about.
+struct JsonValue {
+    enum class Type { Invalid, Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Invalid;
+    std::string_view raw;  // String: contents between quotes (still escaped); Array/Object: including brackets
+
+    bool isValid() const { return type != Type::Invalid; }
+    bool asBool(bool def = false) const;
+    double asDouble(double def = 0.0) const;
+    int64_t asInt(int64_t def = 0) const;
+    std::string asString() const;  // Unescaped (empty if not a string)
+};
+
+namespace json_detail {
+const char* skipWs(const char* p, const char* end);
+// Parse the value starting at p; returns one past its end, or nullptr if malformed
+const char* parseValue(const char* p, const char* end, JsonValue& out);
+// Start of a container's first item (end == closing bracket; returns end if empty)
+const char* enterContainer(const JsonValue& container, const char*& end);
+// Step past the separator after an item (sets done at the closing bracket)
+const char* nextItem(const char* p, const char* end, bool& done);
+}
+
+// Parse a whole document (Invalid on malformed input or trailing garbage)
+JsonValue jsonParse(std::string_view json);
+
+// Call fn(key, value) for each top-level member of an object. Keys are raw
+// (escaped) views. Returns false if the object is malformed.
+template <typename F>
+bool jsonForEachMember(const JsonValue& object, F&& fn) {
+    if (object.type != JsonValue::Type::Object) return false;
+    const char* end = nullptr;
+    const char* p = json_detail::enterContainer(object, end);
+    if (!p) return false;
+    bool done = (p == end);
+    while (!done) {
+        JsonValue key;
+        p = json_detail::parseValue(p, end, key);
+        if (!p || key.type != JsonValue::Type::String) return false;
+        p = json_detail::skipWs(p, end);
+        if (p == end || *p != ':') return false;
+        JsonValue value;
+        p = json_detail::parseValue(json_detail::skipWs(p + 1, end), end, value);
+        if (!p) return false;
+        fn(key.raw, value);
+        p = json_detail::nextItem(p, end, done);
+        if (!p) return false;
+    }
+    return true;
+}
+
+// Call fn(value) for each element of an array. Returning false from fn stops early.
+template <typename F>
+bool jsonForEachElement(const JsonValue& array, F&& fn) {
+    if (array.type != JsonValue::Type::Array) return false;
+    const char* end = nullptr;
+    const char* p = json_detail::enterContainer(array, end);
+    if (!p) return false;
+    bool done = (p == end);
+    while (!done) {
+        JsonValue value;
+        p = json_detail::parseValue(p, end, value);
+        if (!p) return false;
+        if (!fn(value)) return true;
+        p = json_detail::nextItem(p, end, done);
+        if (!p) return false;
+    }
+    return true;
+}
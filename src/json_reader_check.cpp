@@ -0,0 +1,109 @@
+// Grammar check for json_reader: a small corpus of well-formed and malformed
+// documents, run as a test (JSON_READER_CHECK=ON). With JSON_READER_FUZZ
+// defined it is a libFuzzer target instead; the corpus below makes good seeds.
+#include "json_reader.h"
+#include <cstdio>
+
+namespace {
+
+const char* const kValid[] = {
+    "{}",
+    "[]",
+    "0",
+    "-0.5e+10",
+    "\"s\"",
+    "[{}]",
+    "{\"a\":1}",
+    "[1,2,[3,{\"b\":null}]]",
+    " {\"a\" : [true,false] , \"b\":\"x\\u00e9\\\"\"} ",
+    "{\"_audioIdx\":1}",
+    "{\"_audioIdx\":1,\"_subIdx\":2,\"Name\":\"x\"}",
+    "{\"n\":1e300,\"m\":-1e300,\"big\":123456789012345678901234}",
+};
+
+const char* const kMalformed[] = {
+    "",
+    "{abc}",
+    "[1 2,,]",
+    "[1,]",
+    "{\"a\"}",
+    "{\"a\":}",
+    "{\"a\":1,}",
+    "{\"_audioIdx\":1,}",
+    "[01]",
+    "[1.]",
+    "[1e]",
+    "[-]",
+    "{1:2}",
+    "[\"\\x\"]",
+    "[\"\\u12\"]",
+    "[",
+    "]",
+    "{\"a\":1]",
+    "[tru]",
+    "{} x",
+    "[1]]",
+    "\"a\nb\"",
+    "\"unterminated",
+    "[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]",
+};
+
+// Touch every accessor on every value so sanitizers see all paths
+void walk(const JsonValue& v, int depth) {
+    v.asBool();
+    v.asDouble();
+    v.asInt(-1);
+    v.asString();
+    if (depth > 64) return;
+    jsonForEachMember(v, [&](std::string_view, const JsonValue& member) { walk(member, depth + 1); });
+    jsonForEachElement(v, [&](const JsonValue& element) {
+        walk(element, depth + 1);
+        return true;
+    });
+}
+
+}  // namespace
+
+#ifdef JSON_READER_FUZZ
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    walk(jsonParse(std::string_view(reinterpret_cast<const char*>(data), size)), 0);
+    return 0;
+}
+#else
+int main() {
+    int failures = 0;
+    for (const char* doc : kValid) {
+        JsonValue v = jsonParse(doc);
+        if (!v.isValid()) {
+            fprintf(stderr, "rejected valid: %s\n", doc);
+            failures++;
+        }
+        walk(v, 0);
+    }
+    for (const char* doc : kMalformed) {
+        if (jsonParse(doc).isValid()) {
+            fprintf(stderr, "accepted malformed: %s\n", doc);
+            failures++;
+        }
+    }
+
+    // Out-of-range numbers fall back to the default instead of overflowing
+    jsonForEachMember(jsonParse("{\"n\":1e300,\"m\":-1e300,\"big\":123456789012345678901234}"),
+                      [&](std::string_view key, const JsonValue& value) {
+        if (value.asInt(-7) != -7) {
+            fprintf(stderr, "out-of-range %.*s not rejected\n", static_cast<int>(key.size()), key.data());
+            failures++;
+        }
+    });
+
+    // Malformed \u escapes and lone surrogates become U+FFFD
+    JsonValue escaped = jsonParse("\"a\\ud800b\"");
+    if (escaped.asString() != "a\xEF\xBF\xBD" "b") {
+        fprintf(stderr, "lone surrogate not replaced\n");
+        failures++;
+    }
+
+    printf("json_reader: %d failure(s)\n", failures);
+    return failures ? 1 : 0;
+}
+#endif
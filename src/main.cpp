@@ -9,6 +9,7 @@
 #include <condition_variable>
 #include <thread>
 #include <chrono>
+#include <cmath>
 #include <algorithm>
 #include <array>
 #include <atomic>
@@ -27,8 +28,8 @@
 void initMacApplication();
 // Activate window for keyboard focus after SDL window creation
 void activateMacWindow(SDL_Window* window);
-// Wait for NSApplication events (integrates Cocoa + CFRunLoop)
-void waitForMacEvent();
+// Wait for NSApplication events (integrates Cocoa + CFRunLoop); < 0 = no timeout
+void waitForMacEvent(int timeout_ms);
 // Wake the NSApplication event loop from another thread
 void wakeMacEventLoop();
 #endif
@@ -44,27 +45,41 @@ void wakeMacEventLoop();
 #include "context/opengl_frame_context.h"
 #else
 #include "context/egl_context.h"
+#include "compositor/compositor_thread.h"
 #include "context/opengl_frame_context.h"
 #include "player/mpris/media_session_mpris.h"
+#include "metrics_server.h"
 #include <unistd.h>  // For close()
 #endif
 #include "player/media_session.h"
 #include "player/media_session_thread.h"
+#include "player/artwork_cache.h"
 #include "player/video_stack.h"
 #include "player/video_renderer.h"
 #include "player/mpv_event_thread.h"
 #include "player/video_render_thread.h"
+#include "player/player_command.h"
 #include "cef/cef_app.h"
 #include "cef/cef_client.h"
 #include "cef/cef_thread.h"
+#include "cef/resource_pack.h"
+#include "cef/server_warmup.h"
 #include "browser/browser_stack.h"
+#include "compositor/menu_compositor.h"
 #include "input/input_layer.h"
 #include "input/browser_layer.h"
 #include "input/menu_layer.h"
 #include "input/mpv_layer.h"
 #include "input/window_state.h"
 #include "ui/menu_overlay.h"
+#include "ui/perf_hud.h"
 #include "settings.h"
+#include "shader_cache.h"
+#include "startup_graph.h"
+#include "stats.h"
+#include "thread_policy.h"
+#include "trace.h"
+#include "json_reader.h"
 
 // Overlay fade constants
 constexpr float OVERLAY_FADE_DELAY_SEC = 1.0f;
@@ -123,120 +138,52 @@ SDL_SystemCursor cefCursorToSDL(cef_cursor_type_t type) {
 static auto _main_start = std::chrono::steady_clock::now();
 inline long _ms() { return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _main_start).count(); }
 
-// Simple JSON string value extractor (handles escaped quotes)
-std::string jsonGetString(const std::string& json, const std::string& key) {
-    std::string search = "\"" + key + "\":";
-    size_t pos = json.find(search);
-    if (pos == std::string::npos) return "";
-    pos += search.length();
-    // Skip whitespace
-    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t')) pos++;
-    if (pos >= json.size() || json[pos] != '"') return "";
-    pos++;  // Skip opening quote
-    std::string result;
-    while (pos < json.size() && json[pos] != '"') {
-        if (json[pos] == '\\' && pos + 1 < json.size()) {
-            pos++;  // Skip escape char
+// Fields pulled from a Jellyfin item JSON (plus cef_client's _subIdx/_audioIdx) in one pass
+struct ItemMetadata {
+    MediaMetadata media;
+    bool has_normalization_gain = false;
+    double normalization_gain = 0.0;
+    int sub_idx = -1;
+    int audio_idx = -1;
+};
+
+ItemMetadata parseItemJson(const std::string& json) {
+    ItemMetadata item;
+    MediaMetadata& meta = item.media;
+    std::string series_name, season_name, album, first_artist, type;
+    jsonForEachMember(jsonParse(json), [&](std::string_view key, const JsonValue& value) {
+        if (key == "Name") meta.title = value.asString();
+        else if (key == "SeriesName") series_name = value.asString();
+        else if (key == "SeasonName") season_name = value.asString();
+        else if (key == "Album") album = value.asString();
+        else if (key == "Type") type = value.asString();
+        else if (key == "IndexNumber") meta.track_number = static_cast<int>(value.asInt());
+        // RunTimeTicks is in 100ns units, convert to microseconds
+        else if (key == "RunTimeTicks") meta.duration_us = value.asInt() / 10;
+        else if (key == "NormalizationGain" && value.type == JsonValue::Type::Number) {
+            item.has_normalization_gain = true;
+            item.normalization_gain = value.asDouble();
         }
-        result += json[pos++];
-    }
-    return result;
-}
-
-// Extract integer from JSON
-int64_t jsonGetInt(const std::string& json, const std::string& key) {
-    std::string search = "\"" + key + "\":";
-    size_t pos = json.find(search);
-    if (pos == std::string::npos) return 0;
-    pos += search.length();
-    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t')) pos++;
-    std::string num;
-    while (pos < json.size() && (isdigit(json[pos]) || json[pos] == '-')) {
-        num += json[pos++];
-    }
-    return num.empty() ? 0 : std::stoll(num);
-}
-
-// Extract integer from JSON with default value
-int jsonGetIntDefault(const std::string& json, const std::string& key, int defaultVal) {
-    std::string search = "\"" + key + "\":";
-    size_t pos = json.find(search);
-    if (pos == std::string::npos) return defaultVal;
-    pos += search.length();
-    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t')) pos++;
-    if (pos >= json.size()) return defaultVal;
-    bool negative = false;
-    if (json[pos] == '-') { negative = true; pos++; }
-    int val = 0;
-    while (pos < json.size() && json[pos] >= '0' && json[pos] <= '9') {
-        val = val * 10 + (json[pos] - '0');
-        pos++;
-    }
-    return negative ? -val : val;
-}
-
-// Extract double from JSON (with optional hasValue output)
-double jsonGetDouble(const std::string& json, const std::string& key, bool* hasValue = nullptr) {
-    std::string search = "\"" + key + "\":";
-    size_t pos = json.find(search);
-    if (pos == std::string::npos) {
-        if (hasValue) *hasValue = false;
-        return 0.0;
-    }
-    pos += search.length();
-    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t')) pos++;
-    std::string num;
-    while (pos < json.size() && (isdigit(json[pos]) || json[pos] == '-' || json[pos] == '.' || json[pos] == 'e' || json[pos] == 'E' || json[pos] == '+')) {
-        num += json[pos++];
-    }
-    if (hasValue) *hasValue = !num.empty();
-    return num.empty() ? 0.0 : std::stod(num);
-}
-
-// Extract first element from JSON array of strings
-std::string jsonGetFirstArrayString(const std::string& json, const std::string& key) {
-    std::string search = "\"" + key + "\":";
-    size_t pos = json.find(search);
-    if (pos == std::string::npos) return "";
-    pos += search.length();
-    while (pos < json.size() && json[pos] != '[') pos++;
-    if (pos >= json.size()) return "";
-    pos++;  // Skip [
-    while (pos < json.size() && json[pos] != '"' && json[pos] != ']') pos++;
-    if (pos >= json.size() || json[pos] == ']') return "";
-    pos++;  // Skip opening quote
-    std::string result;
-    while (pos < json.size() && json[pos] != '"') {
-        if (json[pos] == '\\' && pos + 1 < json.size()) pos++;
-        result += json[pos++];
-    }
-    return result;
-}
-
-MediaMetadata parseMetadataJson(const std::string& json) {
-    MediaMetadata meta;
-    meta.title = jsonGetString(json, "Name");
+        else if (key == "_subIdx") item.sub_idx = static_cast<int>(value.asInt(-1));
+        else if (key == "_audioIdx") item.audio_idx = static_cast<int>(value.asInt(-1));
+        else if (key == "Artists") {
+            jsonForEachElement(value, [&](const JsonValue& artist) {
+                first_artist = artist.asString();
+                return false;
+            });
+        }
+    });
     // For episodes, use SeriesName as artist; for audio, use Artists array
-    meta.artist = jsonGetString(json, "SeriesName");
-    if (meta.artist.empty()) {
-        meta.artist = jsonGetFirstArrayString(json, "Artists");
-    }
+    meta.artist = !series_name.empty() ? series_name : first_artist;
     // For episodes, use SeasonName as album; for audio, use Album
-    meta.album = jsonGetString(json, "SeasonName");
-    if (meta.album.empty()) {
-        meta.album = jsonGetString(json, "Album");
-    }
-    meta.track_number = static_cast<int>(jsonGetInt(json, "IndexNumber"));
-    // RunTimeTicks is in 100ns units, convert to microseconds
-    meta.duration_us = jsonGetInt(json, "RunTimeTicks") / 10;
+    meta.album = !season_name.empty() ? season_name : album;
     // Detect media type from Type field
-    std::string type = jsonGetString(json, "Type");
     if (type == "Audio") {
         meta.media_type = MediaType::Audio;
     } else if (type == "Movie" || type == "Episode" || type == "Video" || type == "MusicVideo") {
         meta.media_type = MediaType::Video;
     }
-    return meta;
+    return item;
 }
 
 int main(int argc, char* argv[]) {
@@ -246,9 +193,15 @@ int main(int argc, char* argv[]) {
     // Parse arguments (main process only)
     SDL_LogPriority log_level = SDL_LOG_PRIORITY_INFO;
     bool use_dmabuf = false;  // Disable DMA-BUF by default (can cause system freezes)
+    bool startup_report = false;
+    bool show_perf_hud = false;
+    const char* metrics_socket_path = nullptr;  // Linux only
     if (!is_cef_subprocess) {
         const char* log_level_str = nullptr;
         const char* log_file_path = nullptr;
+        const char* trace_file_path = nullptr;
+        const char* thread_priority_str = nullptr;
+        const char* render_cpus_str = nullptr;
         for (int i = 1; i < argc; i++) {
             if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
                 printf("Usage: jellyfin-desktop-cef [options]\n"
@@ -257,8 +210,14 @@ int main(int argc, char* argv[]) {
                        "  -v, --version           Show version information\n"
                        "  --log-level <level>     Set log level (verbose|debug|info|warn|error)\n"
                        "  --log-file <path>       Write logs to file (with timestamps)\n"
+                       "  --startup-report        Print per-phase startup timing and critical path\n"
+                       "  --trace-file <path>     Record a Chrome trace (chrome://tracing, Perfetto) to file\n"
+                       "  --thread-priority <p>   Media thread priority (normal|high|realtime)\n"
+                       "  --render-cpus <list>    Pin the video render thread to CPUs, e.g. 2,3 or 4-7\n"
+                       "  --perf-hud              Show the performance HUD (toggle with Ctrl+Shift+H)\n"
 #if !defined(__APPLE__) && !defined(_WIN32)
                        "  --dmabuf                Enable DMA-BUF zero-copy CEF rendering (experimental)\n"
+                       "  --metrics-socket <path> Serve Prometheus metrics on a Unix socket\n"
 #endif
                        );
                 return 0;
@@ -277,6 +236,28 @@ int main(int argc, char* argv[]) {
                 log_file_path = argv[i] + 11;
             } else if (strcmp(argv[i], "--dmabuf") == 0) {
                 use_dmabuf = true;
+            } else if (strcmp(argv[i], "--trace-file") == 0) {
+                trace_file_path = (i + 1 < argc && argv[i+1][0] != '-') ? argv[++i] : "";
+            } else if (strncmp(argv[i], "--trace-file=", 13) == 0) {
+                trace_file_path = argv[i] + 13;
+            } else if (strcmp(argv[i], "--startup-report") == 0) {
+                startup_report = true;
+            } else if (strcmp(argv[i], "--perf-hud") == 0) {
+                show_perf_hud = true;
+            } else if (strcmp(argv[i], "--thread-priority") == 0) {
+                thread_priority_str = (i + 1 < argc && argv[i+1][0] != '-') ? argv[++i] : "";
+            } else if (strncmp(argv[i], "--thread-priority=", 18) == 0) {
+                thread_priority_str = argv[i] + 18;
+#if !defined(__APPLE__) && !defined(_WIN32)
+            } else if (strcmp(argv[i], "--metrics-socket") == 0) {
+                metrics_socket_path = (i + 1 < argc && argv[i+1][0] != '-') ? argv[++i] : "";
+            } else if (strncmp(argv[i], "--metrics-socket=", 17) == 0) {
+                metrics_socket_path = argv[i] + 17;
+#endif
+            } else if (strcmp(argv[i], "--render-cpus") == 0) {
+                render_cpus_str = (i + 1 < argc && argv[i+1][0] != '-') ? argv[++i] : "";
+            } else if (strncmp(argv[i], "--render-cpus=", 14) == 0) {
+                render_cpus_str = argv[i] + 14;
             } else if (argv[i][0] == '-') {
                 fprintf(stderr, "Unknown option: %s\n", argv[i]);
                 return 1;
@@ -292,6 +273,18 @@ int main(int argc, char* argv[]) {
             }
             log_level = static_cast<SDL_LogPriority>(level);
         }
+        thread_policy::Config thread_config;
+        if (thread_priority_str && thread_priority_str[0] &&
+            !thread_policy::parsePriority(thread_priority_str, thread_config.priority)) {
+            fprintf(stderr, "Invalid thread priority: %s\n", thread_priority_str);
+            return 1;
+        }
+        if (render_cpus_str && render_cpus_str[0] &&
+            !thread_policy::parseCpuList(render_cpus_str, thread_config.render_cpus)) {
+            fprintf(stderr, "Invalid CPU list: %s\n", render_cpus_str);
+            return 1;
+        }
+        thread_policy::configure(thread_config);
         if (log_file_path && log_file_path[0]) {
             g_log_file = fopen(log_file_path, "a");
             if (!g_log_file) {
@@ -302,6 +295,15 @@ int main(int argc, char* argv[]) {
 
         initLogging(log_level);
 
+        if (trace_file_path && trace_file_path[0]) {
+            if (!trace::start(trace_file_path)) {
+                LOG_ERROR(LOG_MAIN, "Failed to open trace file: %s", trace_file_path);
+                return 1;
+            }
+            TRACE_THREAD_NAME("main");
+            LOG_INFO(LOG_MAIN, "Tracing to %s", trace_file_path);
+        }
+
         // Startup banner
         LOG_INFO(LOG_MAIN, "jellyfin-desktop-cef " APP_VERSION_STRING " built " __DATE__ " " __TIME__);
         LOG_INFO(LOG_MAIN, "CEF " CEF_VERSION);
@@ -381,6 +383,98 @@ int main(int argc, char* argv[]) {
     PFMoveToApplicationsFolderIfNecessary();
 #endif
 
+    // CEF settings (CefThread sets external_message_pump)
+    CefSettings settings;
+    settings.no_sandbox = true;
+    settings.windowless_rendering_enabled = true;
+
+#ifdef __APPLE__
+    // macOS: Set framework path (cef_framework_path set earlier during CEF loading)
+    CefString(&settings.framework_dir_path).FromString((cef_framework_path / "Chromium Embedded Framework.framework").string());
+    // Use main executable as subprocess - it handles CefExecuteProcess early
+    CefString(&settings.browser_subprocess_path).FromString((exe_path / "jellyfin-desktop-cef").string());
+#elif defined(_WIN32)
+    // Windows: Get exe path
+    wchar_t exe_buf[MAX_PATH];
+    GetModuleFileNameW(nullptr, exe_buf, MAX_PATH);
+    std::filesystem::path exe_path = std::filesystem::path(exe_buf).parent_path();
+    CefString(&settings.resources_dir_path).FromString(exe_path.string());
+    CefString(&settings.locales_dir_path).FromString((exe_path / "locales").string());
+#else
+    std::filesystem::path exe_path = std::filesystem::canonical("/proc/self/exe").parent_path();
+#ifdef CEF_RESOURCES_DIR
+    CefString(&settings.resources_dir_path).FromString(CEF_RESOURCES_DIR);
+    CefString(&settings.locales_dir_path).FromString(CEF_RESOURCES_DIR "/locales");
+#else
+    CefString(&settings.resources_dir_path).FromString(exe_path.string());
+    CefString(&settings.locales_dir_path).FromString((exe_path / "locales").string());
+#endif
+#endif
+
+    // app:// web resources: next to the executable, or in the bundle's Resources
+    if (!ResourcePack::instance().open((exe_path / "app_resources.pak").string()) &&
+        !ResourcePack::instance().open((exe_path.parent_path() / "Resources" / "app_resources.pak").string())) {
+        LOG_ERROR(LOG_MAIN, "app_resources.pak not found next to %s", exe_path.string().c_str());
+    }
+
+    // Cache path
+    std::filesystem::path cache_path;
+#ifdef _WIN32
+    if (const char* appdata = std::getenv("LOCALAPPDATA")) {
+        cache_path = std::filesystem::path(appdata) / "jellyfin-desktop-cef";
+    }
+#elif defined(__APPLE__)
+    if (const char* home = std::getenv("HOME")) {
+        cache_path = std::filesystem::path(home) / "Library" / "Caches" / "jellyfin-desktop-cef";
+    }
+#else
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
+        cache_path = std::filesystem::path(xdg) / "jellyfin-desktop-cef";
+    } else if (const char* home = std::getenv("HOME")) {
+        cache_path = std::filesystem::path(home) / ".cache" / "jellyfin-desktop-cef";
+    }
+#endif
+    if (!cache_path.empty()) {
+        std::filesystem::create_directories(cache_path);
+        CefString(&settings.root_cache_path).FromString(cache_path.string());
+        CefString(&settings.cache_path).FromString((cache_path / "cache").string());
+        ArtworkCache::instance().init((cache_path / "artwork").string());
+        ShaderCache::instance().init((cache_path / "shaders").string());
+    }
+
+    // Capture stderr before CEF starts (routes Chromium logs through SDL)
+    initStderrCapture();
+
+#ifndef __APPLE__
+    // Windows/Linux: CEF runs on a dedicated thread
+    CefThread cefThread;
+#endif
+    MenuOverlay menu;
+    PerfHud hud;
+
+    // Startup task graph: disk-bound and CEF init run on workers while the
+    // main thread sets up the window, GL and mpv
+    StartupGraph startup;
+    auto settings_task = startup.async("settings", {}, [] {
+        Settings::instance().load();  // missing file is not an error
+        return true;
+    });
+#ifndef __APPLE__
+    // Browser creation waits on this; everything up to it overlaps CefInitialize
+    auto cef_task = startup.async("CEF init", {}, [&] {
+        return cefThread.start(main_args, settings, app);
+    });
+    // Saved server: open the connection and prefetch the web client while
+    // the window, video stack and compositors are still being set up
+    startup.async("network warm-up", {cef_task, settings_task}, [&startup, cef_task] {
+        if (!startup.wait(cef_task)) return false;
+        server_warmup::start(Settings::instance().serverUrl());
+        return true;
+    });
+#endif
+    auto font_task = startup.async("menu font", {}, [&menu] { return menu.init(); });
+
+    auto window_phase = startup.begin("SDL window");
     // SDL initialization with OpenGL (for main surface CEF overlay)
     if (!SDL_Init(SDL_INIT_VIDEO)) {
         LOG_ERROR(LOG_MAIN, "SDL_Init failed: %s", SDL_GetError());
@@ -423,6 +517,7 @@ int main(int argc, char* argv[]) {
     }
 
     SDL_StartTextInput(window);
+    startup.end(window_phase);
 
 #ifdef __APPLE__
     // Window activation is deferred until first WINDOW_EXPOSED event
@@ -431,7 +526,9 @@ int main(int argc, char* argv[]) {
 
 #ifdef __APPLE__
     // Create video stack
+    auto video_phase = startup.begin("video stack");
     VideoStack videoStack = VideoStack::create(window, width, height);
+    startup.end(video_phase, videoStack.player && videoStack.renderer);
     if (!videoStack.player || !videoStack.renderer) {
         SDL_DestroyWindow(window);
         SDL_Quit();
@@ -456,7 +553,10 @@ int main(int argc, char* argv[]) {
 #elif defined(_WIN32)
     // Windows: Initialize WGL context for OpenGL rendering
     WGLContext wgl;
-    if (!wgl.init(window)) {
+    auto gl_phase = startup.begin("WGL context");
+    bool gl_ok = wgl.init(window);
+    startup.end(gl_phase, gl_ok);
+    if (!gl_ok) {
         LOG_ERROR(LOG_GL, "WGL init failed");
         SDL_DestroyWindow(window);
         SDL_Quit();
@@ -464,7 +564,9 @@ int main(int argc, char* argv[]) {
     }
 
     // Create video stack
+    auto video_phase = startup.begin("video stack");
     VideoStack videoStack = VideoStack::create(window, width, height, &wgl);
+    startup.end(video_phase, videoStack.player && videoStack.renderer);
     if (!videoStack.player || !videoStack.renderer) {
         SDL_DestroyWindow(window);
         SDL_Quit();
@@ -486,7 +588,10 @@ int main(int argc, char* argv[]) {
 #else
     // Linux: Initialize EGL context for OpenGL rendering
     EGLContext_ egl;
-    if (!egl.init(window)) {
+    auto gl_phase = startup.begin("EGL context");
+    bool gl_ok = egl.init(window);
+    startup.end(gl_phase, gl_ok);
+    if (!gl_ok) {
         LOG_ERROR(LOG_GL, "EGL init failed");
         SDL_DestroyWindow(window);
         SDL_Quit();
@@ -494,7 +599,9 @@ int main(int argc, char* argv[]) {
     }
 
     // Create video stack (detects Wayland vs X11 internally)
+    auto video_phase = startup.begin("video stack");
     VideoStack videoStack = VideoStack::create(window, width, height, &egl);
+    startup.end(video_phase, videoStack.player && videoStack.renderer);
     if (!videoStack.player || !videoStack.renderer) {
         SDL_DestroyWindow(window);
         SDL_Quit();
@@ -518,110 +625,60 @@ int main(int argc, char* argv[]) {
 
     CompositorContext compositor_ctx;
     compositor_ctx.gl_context = &egl;
-#endif
-
-    // Load settings
-    Settings::instance().load();
-
-    // CEF settings (CefThread sets external_message_pump)
-    CefSettings settings;
-    settings.no_sandbox = true;
-    settings.windowless_rendering_enabled = true;
 
-#ifdef __APPLE__
-    // macOS: Set framework path (cef_framework_path set earlier during CEF loading)
-    CefString(&settings.framework_dir_path).FromString((cef_framework_path / "Chromium Embedded Framework.framework").string());
-    // Use main executable as subprocess - it handles CefExecuteProcess early
-    CefString(&settings.browser_subprocess_path).FromString((exe_path / "jellyfin-desktop-cef").string());
-#elif defined(_WIN32)
-    // Windows: Get exe path
-    wchar_t exe_buf[MAX_PATH];
-    GetModuleFileNameW(nullptr, exe_buf, MAX_PATH);
-    std::filesystem::path exe_path = std::filesystem::path(exe_buf).parent_path();
-    CefString(&settings.resources_dir_path).FromString(exe_path.string());
-    CefString(&settings.locales_dir_path).FromString((exe_path / "locales").string());
-#else
-    std::filesystem::path exe_path = std::filesystem::canonical("/proc/self/exe").parent_path();
-#ifdef CEF_RESOURCES_DIR
-    CefString(&settings.resources_dir_path).FromString(CEF_RESOURCES_DIR);
-    CefString(&settings.locales_dir_path).FromString(CEF_RESOURCES_DIR "/locales");
-#else
-    CefString(&settings.resources_dir_path).FromString(exe_path.string());
-    CefString(&settings.locales_dir_path).FromString((exe_path / "locales").string());
-#endif
+    // Takes over the GL context once startup GL work is done
+    CompositorThread compositor_thread;
 #endif
 
-    // Cache path
-    std::filesystem::path cache_path;
-#ifdef _WIN32
-    if (const char* appdata = std::getenv("LOCALAPPDATA")) {
-        cache_path = std::filesystem::path(appdata) / "jellyfin-desktop-cef";
-    }
-#elif defined(__APPLE__)
-    if (const char* home = std::getenv("HOME")) {
-        cache_path = std::filesystem::path(home) / "Library" / "Caches" / "jellyfin-desktop-cef";
-    }
-#else
-    if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
-        cache_path = std::filesystem::path(xdg) / "jellyfin-desktop-cef";
-    } else if (const char* home = std::getenv("HOME")) {
-        cache_path = std::filesystem::path(home) / ".cache" / "jellyfin-desktop-cef";
-    }
-#endif
-    if (!cache_path.empty()) {
-        std::filesystem::create_directories(cache_path);
-        CefString(&settings.root_cache_path).FromString(cache_path.string());
-        CefString(&settings.cache_path).FromString((cache_path / "cache").string());
-    }
 
-    // Capture stderr before CEF starts (routes Chromium logs through SDL)
-    initStderrCapture();
+    // With a saved server the overlay browser (server picker) is only created
+    // if loading the server fails; until then the clear color is the splash
+    startup.wait(settings_task);
+    const bool have_saved_server = !Settings::instance().serverUrl().empty();
 
 #ifdef __APPLE__
     // Pre-create Metal compositors BEFORE CefInitialize to avoid startup delay
     // Metal device/pipeline/texture creation takes time; do it while CEF init runs
-    auto overlay_compositor = std::make_unique<MetalCompositor>();
-    overlay_compositor->init(window, physical_width, physical_height);
-    LOG_DEBUG(LOG_COMPOSITOR, "Pre-created overlay Metal compositor");
+    auto metal_phase = startup.begin("Metal compositors");
+    std::unique_ptr<MetalCompositor> overlay_compositor;
+    if (!have_saved_server) {
+        overlay_compositor = std::make_unique<MetalCompositor>();
+        overlay_compositor->init(window, physical_width, physical_height);
+        LOG_DEBUG(LOG_COMPOSITOR, "Pre-created overlay Metal compositor");
+    }
 
     auto main_compositor = std::make_unique<MetalCompositor>();
     main_compositor->init(window, physical_width, physical_height);
     LOG_DEBUG(LOG_COMPOSITOR, "Pre-created main Metal compositor");
+    startup.end(metal_phase);
 
     // macOS: Use external_message_pump on main thread (CEF doesn't handle separate thread well)
     settings.external_message_pump = true;
-    if (!CefInitialize(main_args, settings, app, nullptr)) {
+    auto cef_task = startup.begin("CEF init");
+    bool cef_ok = CefInitialize(main_args, settings, app, nullptr);
+    startup.end(cef_task, cef_ok);
+    if (!cef_ok) {
         LOG_ERROR(LOG_CEF, "CefInitialize failed");
         SDL_DestroyWindow(window);
         SDL_Quit();
         return 1;
     }
     LOG_INFO(LOG_CEF, "CEF context initialized");
-#else
-    // Windows/Linux: Start CEF on dedicated thread
-    CefThread cefThread;
-    if (!cefThread.start(main_args, settings, app)) {
-        LOG_ERROR(LOG_CEF, "CefThread start failed");
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return 1;
-    }
+    startup.wait(settings_task);
+    server_warmup::start(Settings::instance().serverUrl());
 #endif
 
     // Browser stack manages all browsers and their paint buffers
     BrowserStack browsers;
-    bool paint_size_matched = true;  // Track if last paint matched compositor size
-
-    // Player command queue
-    struct PlayerCmd {
-        std::string cmd;
-        std::string url;
-        int intArg;
-        double doubleArg;
-        std::string metadata;  // JSON for load command
+    std::atomic<bool> paint_size_matched{true};  // Track if last paint matched compositor size (CEF thread)
+
+    // Player commands from the browser and media session threads
+    PlayerCommandQueue player_cmds;
+    std::vector<PlayerCommand> cmd_batch;  // main thread
+    auto queueCommand = [&player_cmds, wakeMainLoop](PlayerCommand cmd) {
+        player_cmds.push(std::move(cmd));
+        wakeMainLoop();  // Wake from idle wait to process command
     };
-    std::mutex cmd_mutex;
-    std::vector<PlayerCmd> pending_cmds;
 
     // Initialize media session with platform backend
     MediaSession mediaSession;
@@ -635,54 +692,42 @@ int main(int argc, char* argv[]) {
     MediaSessionThread mediaSessionThread;
     mediaSessionThread.start(&mediaSession);
     mediaSession.onPlay = [&]() {
-        std::lock_guard<std::mutex> lock(cmd_mutex);
-        pending_cmds.push_back({"media_action", "play", 0, 0.0});
+        queueCommand({PlayerCommand::Type::MediaAction, "play"});
     };
     mediaSession.onPause = [&]() {
-        std::lock_guard<std::mutex> lock(cmd_mutex);
-        pending_cmds.push_back({"media_action", "pause", 0, 0.0});
+        queueCommand({PlayerCommand::Type::MediaAction, "pause"});
     };
     mediaSession.onPlayPause = [&]() {
-        std::lock_guard<std::mutex> lock(cmd_mutex);
-        pending_cmds.push_back({"media_action", "play_pause", 0, 0.0});
+        queueCommand({PlayerCommand::Type::MediaAction, "play_pause"});
     };
     mediaSession.onStop = [&]() {
-        std::lock_guard<std::mutex> lock(cmd_mutex);
-        pending_cmds.push_back({"media_action", "stop", 0, 0.0});
+        queueCommand({PlayerCommand::Type::MediaAction, "stop"});
     };
     mediaSession.onSeek = [&](int64_t position_us) {
-        std::lock_guard<std::mutex> lock(cmd_mutex);
-        pending_cmds.push_back({"media_seek", "", static_cast<int>(position_us / 1000), 0.0});
+        queueCommand({PlayerCommand::Type::MediaSeek, "", static_cast<int>(position_us / 1000)});
     };
     mediaSession.onNext = [&]() {
-        std::lock_guard<std::mutex> lock(cmd_mutex);
-        pending_cmds.push_back({"media_action", "next", 0, 0.0});
+        queueCommand({PlayerCommand::Type::MediaAction, "next"});
     };
     mediaSession.onPrevious = [&]() {
-        std::lock_guard<std::mutex> lock(cmd_mutex);
-        pending_cmds.push_back({"media_action", "previous", 0, 0.0});
+        queueCommand({PlayerCommand::Type::MediaAction, "previous"});
     };
     mediaSession.onRaise = [&]() {
         SDL_RaiseWindow(window);
     };
     mediaSession.onSetRate = [&](double rate) {
-        std::lock_guard<std::mutex> lock(cmd_mutex);
-        pending_cmds.push_back({"media_rate", "", 0, rate});
+        queueCommand({PlayerCommand::Type::MediaRate, "", 0, rate});
     };
 
     // Overlay browser state
-    enum class OverlayState { SHOWING, WAITING, FADING, HIDDEN };
+    // SPLASH: saved server loading with no overlay browser, clear color only
+    enum class OverlayState { SPLASH, SHOWING, WAITING, FADING, HIDDEN };
     OverlayState overlay_state = OverlayState::SHOWING;
     std::chrono::steady_clock::time_point overlay_fade_start;
     float overlay_browser_alpha = 1.0f;
     float clear_color = 16.0f / 255.0f;  // #101010 until fade begins
-    std::string pending_server_url;
-
-    // Context menu overlay
-    MenuOverlay menu;
-    if (!menu.init()) {
-        LOG_WARN(LOG_MENU, "Failed to init menu overlay (no font found)");
-    }
+    std::mutex server_url_mutex;
+    std::string pending_server_url;  // set by the overlay's loadServer
 
     // Cursor state
     SDL_Cursor* current_cursor = nullptr;
@@ -693,65 +738,6 @@ int main(int argc, char* argv[]) {
         SDL_GetWindowSizeInPixels(window, &w, &h);
     };
 
-    // Create overlay browser entry
-    auto overlay_entry = std::make_unique<BrowserEntry>();
-    BrowserEntry* overlay_ptr = overlay_entry.get();  // save pointer before move
-#ifdef __APPLE__
-    // Use pre-created Metal compositor (avoids startup delay)
-    overlay_ptr->setCompositor(std::move(overlay_compositor));
-#else
-    if (!overlay_ptr->initCompositor(compositor_ctx, physical_width, physical_height)) {
-        LOG_ERROR(LOG_OVERLAY, "Overlay compositor init failed");
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return 1;
-    }
-#endif
-    auto overlay_paint_cb = overlay_ptr->makePaintCallback();
-
-    // Overlay browser client (for loading UI)
-    CefRefPtr<OverlayClient> overlay_client(new OverlayClient(width, height,
-        [overlay_paint_cb](const void* buffer, int w, int h) {
-            static bool first_overlay_paint = true;
-            if (first_overlay_paint) {
-                LOG_DEBUG(LOG_OVERLAY, "first paint callback: %dx%d", w, h);
-                first_overlay_paint = false;
-            }
-            overlay_paint_cb(buffer, w, h);
-        },
-        [&](const std::string& url) {
-            // loadServer callback - start loading main browser
-            LOG_INFO(LOG_OVERLAY, "loadServer callback: %s", url.c_str());
-            std::lock_guard<std::mutex> lock(cmd_mutex);
-            pending_server_url = url;
-        },
-        getPhysicalSize,
-#if !defined(__APPLE__) && !defined(_WIN32)
-        // Accelerated paint callback for overlay
-        [overlay_ptr, wakeMainLoop](int fd, uint32_t stride, uint64_t modifier, int w, int h) {
-            overlay_ptr->compositor->queueDmabuf(fd, stride, modifier, w, h);
-            wakeMainLoop();
-        }
-#else
-        nullptr
-#endif
-#ifdef __APPLE__
-        // IOSurface callback for macOS accelerated paint - queue for import on main thread
-        , [overlay_ptr](void* surface, int format, int w, int h) {
-            overlay_ptr->compositor->queueIOSurface(surface, format, w, h);
-        }
-#endif
-    ));
-    overlay_ptr->client = overlay_client;
-    overlay_ptr->getBrowser = [overlay_client]() { return overlay_client->browser(); };
-    overlay_ptr->resizeBrowser = [overlay_client](int w, int h) { overlay_client->resize(w, h); };
-    overlay_ptr->getInputReceiver = [overlay_client]() -> InputReceiver* { return overlay_client.get(); };
-    overlay_ptr->isClosed = [overlay_client]() { return overlay_client->isClosed(); };
-    overlay_ptr->input_layer = std::make_unique<BrowserLayer>(overlay_client.get());
-    overlay_ptr->input_layer->setWindowSize(width, height);
-    overlay_ptr->wake_main_loop = wakeMainLoop;
-    browsers.add("overlay", std::move(overlay_entry));
-
     // Track who initiated fullscreen (only changes from NONE, returns to NONE on exit)
     enum class FullscreenSource { NONE, WM, CEF };
     FullscreenSource fullscreen_source = FullscreenSource::NONE;
@@ -763,7 +749,10 @@ int main(int argc, char* argv[]) {
     // Use pre-created Metal compositor (avoids startup delay)
     main_ptr->setCompositor(std::move(main_compositor));
 #else
-    if (!main_ptr->initCompositor(compositor_ctx, physical_width, physical_height)) {
+    auto main_comp_phase = startup.begin("main compositor");
+    bool main_comp_ok = main_ptr->initCompositor(compositor_ctx, physical_width, physical_height);
+    startup.end(main_comp_phase, main_comp_ok);
+    if (!main_comp_ok) {
         LOG_ERROR(LOG_COMPOSITOR, "Main compositor init failed");
         SDL_DestroyWindow(window);
         SDL_Quit();
@@ -778,22 +767,29 @@ int main(int argc, char* argv[]) {
             if (paint_count++ % 100 == 0) {
                 LOG_DEBUG(LOG_CEF, "main browser paint #%d: %dx%d", paint_count, w, h);
             }
-            main_paint_cb(buffer, w, h);
-            // Track if paint matched compositor size
+            // Track if paint matched compositor size (before the paint wakes the main loop)
             if (w == static_cast<int>(main_ptr->compositor->width()) &&
                 h == static_cast<int>(main_ptr->compositor->height())) {
                 paint_size_matched = true;
             }
+            main_paint_cb(buffer, w, h);
         },
         [&](const std::string& cmd, const std::string& arg, int intArg, const std::string& metadata) {
-            std::lock_guard<std::mutex> lock(cmd_mutex);
-            pending_cmds.push_back({cmd, arg, intArg, 0.0, metadata});
-            wakeMainLoop();  // Wake from idle wait to process command
+            PlayerCommand typed;
+            if (PlayerCommand::fromMessage(cmd, arg, intArg, metadata, typed)) {
+                queueCommand(std::move(typed));
+            }
         },
 #if !defined(__APPLE__) && !defined(_WIN32)
-        // Accelerated paint callback - queue dmabuf for import on main thread
-        [main_ptr, wakeMainLoop](int fd, uint32_t stride, uint64_t modifier, int w, int h) {
+        // Accelerated paint callback (CEF UI thread) - queue dmabuf for import
+        // on the compositor thread
+        [main_ptr, wakeMainLoop, &paint_size_matched](int fd, uint32_t stride, uint64_t modifier, int w, int h) {
+            if (w == static_cast<int>(main_ptr->compositor->width()) &&
+                h == static_cast<int>(main_ptr->compositor->height())) {
+                paint_size_matched = true;
+            }
             main_ptr->compositor->queueDmabuf(fd, stride, modifier, w, h);
+            main_ptr->paint_pending.store(true);
             wakeMainLoop();
         },
 #else
@@ -831,6 +827,7 @@ int main(int argc, char* argv[]) {
         // IOSurface callback for macOS accelerated paint - queue for import on main thread
         , [main_ptr](void* surface, int format, int w, int h) {
             main_ptr->compositor->queueIOSurface(surface, format, w, h);
+            main_ptr->paint_pending.store(true);
         }
 #endif
     ));
@@ -883,37 +880,171 @@ int main(int argc, char* argv[]) {
     overlay_browser_settings.background_color = 0;
     overlay_browser_settings.windowless_frame_rate = browser_settings.windowless_frame_rate;
 
-    std::string overlay_html_path = "app://resources/index.html";
-    CefBrowserHost::CreateBrowser(overlay_window_info, overlay_client, overlay_html_path, overlay_browser_settings, nullptr, nullptr);
+    // Overlay browser (server picker). Created at startup without a saved
+    // server, otherwise on demand when the saved server fails to load.
+    // GL work outside the render path (creating or replacing a compositor)
+    // must run where the context is current
+    auto onGpuThread = [&](const std::function<void()>& task) {
+#if !defined(__APPLE__) && !defined(_WIN32)
+        compositor_thread.runSync(task);
+#else
+        task();
+#endif
+    };
+
+    // Browsers resize on this thread, their compositors where the context is
+    auto resizeBrowsers = [&](int logical_w, int logical_h, int physical_w, int physical_h) {
+#if !defined(__APPLE__) && !defined(_WIN32)
+        browsers.resizeAll(logical_w, logical_h);
+        compositor_thread.post([&browsers, physical_w, physical_h]() {
+            browsers.resizeCompositors(physical_w, physical_h);
+        });
+#else
+        browsers.resizeAll(logical_w, logical_h, physical_w, physical_h);
+#endif
+    };
+
+    // at_startup: record a startup-graph phase (not for on-demand reopening)
+    auto createOverlay = [&](bool at_startup) -> bool {
+        int logical_w, logical_h, pixel_w, pixel_h;
+        SDL_GetWindowSize(window, &logical_w, &logical_h);
+        SDL_GetWindowSizeInPixels(window, &pixel_w, &pixel_h);
+
+        auto overlay_entry = std::make_unique<BrowserEntry>();
+        BrowserEntry* overlay_ptr = overlay_entry.get();  // save pointer before move
+#ifdef __APPLE__
+        // Use pre-created Metal compositor if there is one (avoids startup delay)
+        if (overlay_compositor) {
+            overlay_ptr->setCompositor(std::move(overlay_compositor));
+        }
+#endif
+        auto overlay_comp_phase = at_startup ? startup.begin("overlay compositor") : -1;
+        bool overlay_comp_ok = false;
+        onGpuThread([&]() { overlay_comp_ok = overlay_ptr->initCompositor(compositor_ctx, pixel_w, pixel_h); });
+        if (at_startup) startup.end(overlay_comp_phase, overlay_comp_ok);
+        if (!overlay_comp_ok) {
+            LOG_ERROR(LOG_OVERLAY, "Overlay compositor init failed");
+            return false;
+        }
+        auto overlay_paint_cb = overlay_ptr->makePaintCallback();
+
+        // Overlay browser client (for loading UI)
+        CefRefPtr<OverlayClient> overlay_client(new OverlayClient(logical_w, logical_h,
+            [overlay_paint_cb](const void* buffer, int w, int h) {
+                static bool first_overlay_paint = true;
+                if (first_overlay_paint) {
+                    LOG_DEBUG(LOG_OVERLAY, "first paint callback: %dx%d", w, h);
+                    first_overlay_paint = false;
+                }
+                overlay_paint_cb(buffer, w, h);
+            },
+            [&](const std::string& url) {
+                // loadServer callback - start loading main browser
+                LOG_INFO(LOG_OVERLAY, "loadServer callback: %s", url.c_str());
+                {
+                    std::lock_guard<std::mutex> lock(server_url_mutex);
+                    pending_server_url = url;
+                }
+                wakeMainLoop();
+            },
+            getPhysicalSize,
+#if !defined(__APPLE__) && !defined(_WIN32)
+            // Accelerated paint callback for overlay
+            [overlay_ptr, wakeMainLoop](int fd, uint32_t stride, uint64_t modifier, int w, int h) {
+                overlay_ptr->compositor->queueDmabuf(fd, stride, modifier, w, h);
+                overlay_ptr->paint_pending.store(true);
+                wakeMainLoop();
+            }
+#else
+            nullptr
+#endif
+#ifdef __APPLE__
+            // IOSurface callback for macOS accelerated paint - queue for import on main thread
+            , [overlay_ptr](void* surface, int format, int w, int h) {
+                overlay_ptr->compositor->queueIOSurface(surface, format, w, h);
+                overlay_ptr->paint_pending.store(true);
+            }
+#endif
+        ));
+        overlay_ptr->client = overlay_client;
+        overlay_ptr->getBrowser = [overlay_client]() { return overlay_client->browser(); };
+        overlay_ptr->resizeBrowser = [overlay_client](int w, int h) { overlay_client->resize(w, h); };
+        overlay_ptr->getInputReceiver = [overlay_client]() -> InputReceiver* { return overlay_client.get(); };
+        overlay_ptr->isClosed = [overlay_client]() { return overlay_client->isClosed(); };
+        overlay_ptr->input_layer = std::make_unique<BrowserLayer>(overlay_client.get());
+        overlay_ptr->input_layer->setWindowSize(logical_w, logical_h);
+        overlay_ptr->wake_main_loop = wakeMainLoop;
+        onGpuThread([&]() { browsers.add("overlay", std::move(overlay_entry)); });  // replaces a closed one
+
+        std::string overlay_html_path = "app://resources/index.html";
+        CefBrowserHost::CreateBrowser(overlay_window_info, overlay_client, overlay_html_path, overlay_browser_settings, nullptr, nullptr);
+        return true;
+    };
+
+    // Browsers need CEF, the saved server URL and (for context menus) the font
+    auto browsers_phase = startup.begin("create browsers", {cef_task, settings_task, font_task});
+    if (!startup.wait(cef_task)) {
+        LOG_ERROR(LOG_CEF, "CefThread start failed");
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+    if (!startup.wait(font_task)) {
+        LOG_WARN(LOG_MENU, "Failed to init menu overlay (no font found)");
+    }
 
     // State tracking
     using Clock = std::chrono::steady_clock;
 
     // Main browser: load saved server immediately, or wait for overlay IPC
     std::string saved_url = Settings::instance().serverUrl();
-    if (saved_url.empty()) {
+    if (!have_saved_server) {
         // No saved server - create with blank, wait for overlay loadServer IPC
+        if (!createOverlay(true)) {
+            SDL_DestroyWindow(window);
+            SDL_Quit();
+            return 1;
+        }
         LOG_INFO(LOG_MAIN, "Waiting for overlay to provide server URL");
         CefBrowserHost::CreateBrowser(window_info, client, "about:blank", browser_settings, nullptr, nullptr);
     } else {
-        // Have saved server - start loading immediately, begin overlay fade
-        overlay_state = OverlayState::WAITING;
+        // Have saved server - start loading immediately behind the splash
+        overlay_state = OverlayState::SPLASH;
         overlay_fade_start = Clock::now();
         LOG_INFO(LOG_MAIN, "Loading saved server: %s", saved_url.c_str());
         CefBrowserHost::CreateBrowser(window_info, client, saved_url, browser_settings, nullptr, nullptr);
     }
+    startup.end(browsers_phase);
+    if (startup_report) {
+        startup.report();
+    }
+
     // Input routing stack - use BrowserStack for input layers
     MenuLayer menu_layer(&menu);
     InputStack input_stack;
-    input_stack.push(browsers.getInputLayer("overlay"));  // Start with overlay
+    const char* initial_layer = have_saved_server ? "main" : "overlay";
+    input_stack.push(browsers.getInputLayer(initial_layer));
 
     // Track which browser layer is active (for WindowStateNotifier)
-    BrowserLayer* active_browser = browsers.getInputLayer("overlay");
+    BrowserLayer* active_browser = browsers.getInputLayer(initial_layer);
 
     // Push/pop menu layer on open/close
     menu.setOnOpen([&]() { input_stack.push(&menu_layer); });
     menu.setOnClose([&]() { input_stack.remove(&menu_layer); });
 
+    // Context menu draws as its own layer above the browsers
+    MenuCompositor menu_compositor;
+    menu_compositor.init(compositor_ctx);
+    // Perf HUD likewise, above the menu
+    MenuCompositor hud_compositor;
+    hud_compositor.init(compositor_ctx);
+    if (show_perf_hud) hud.toggle();
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+    // Startup GL work is done: compositing moves off the main thread
+    compositor_thread.start(&egl, &frameContext, &browsers, &menu_compositor, &hud_compositor);
+#endif
+
     // Window state notifications
     WindowStateNotifier window_state;
     window_state.add(active_browser);
@@ -932,12 +1063,34 @@ int main(int argc, char* argv[]) {
     bool window_activated = false;  // Activate window on first expose event
 #endif
 #if !defined(_WIN32) && !defined(__APPLE__)
-    auto last_resize_time = Clock::now() - std::chrono::seconds(10);  // Track when resize stopped
+    // Live resize: the window follows every step, stretching the browsers'
+    // last frames, while CEF is asked to re-layout at most this often
+    constexpr auto BROWSER_RESIZE_INTERVAL = std::chrono::milliseconds(100);
+    bool browser_resize_pending = false;
+    auto next_browser_resize = Clock::now();
+    auto applyBrowserResize = [&]() {
+        int physical_w, physical_h;
+        SDL_GetWindowSizeInPixels(window, &physical_w, &physical_h);
+        resizeBrowsers(current_width, current_height, physical_w, physical_h);
+        browser_resize_pending = false;
+        next_browser_resize = Clock::now() + BROWSER_RESIZE_INTERVAL;
+    };
 #endif
 
     // Start mpv event thread - processes events and queues them for main thread
     MpvEventThread mpvEvents;
-    mpvEvents.start(mpv);
+    mpvEvents.start(mpv, wakeMainLoop);
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+    // Opt-in metrics endpoint; scrapes run on its own thread
+    MetricsServer metricsServer;
+    if (metrics_socket_path && metrics_socket_path[0]) {
+        MetricsServer::Sources sources;
+        sources.playback = [mpv]() { return mpv->getPlaybackStats(); };
+        sources.mpv_event_queue_depth = [&mpvEvents]() { return mpvEvents.queueDepth(); };
+        metricsServer.start(metrics_socket_path, std::move(sources));
+    }
+#endif
 
 #if !defined(_WIN32) && !defined(__APPLE__)
     // Start video render thread - renders video on dedicated thread to avoid blocking main loop
@@ -946,6 +1099,9 @@ int main(int argc, char* argv[]) {
     mpv->setRedrawCallback([&videoRenderThread]() {
         videoRenderThread.notify();
     });
+#else
+    // Video renders on the main thread: wake it when mpv has a new frame
+    mpv->setRedrawCallback(wakeMainLoop);
 #endif
 
 #ifdef __APPLE__
@@ -995,6 +1151,7 @@ int main(int argc, char* argv[]) {
             }
 
             // Flush and composite all browsers (back-to-front order)
+            ctx->browsers->markPaintsSubmitted();
             ctx->browsers->renderAll(*ctx->current_width, *ctx->current_height);
         }
 
@@ -1009,29 +1166,60 @@ int main(int argc, char* argv[]) {
     App::DoWork();
 #endif
 
+    // Playback clock for the web UI: JS interpolates currentTime from the last
+    // anchor, so only re-anchor on state changes, drift, or a slow heartbeat
+    constexpr auto CLOCK_ANCHOR_INTERVAL = std::chrono::milliseconds(1000);
+    constexpr double CLOCK_DRIFT_TOLERANCE_MS = 100.0;
+    struct {
+        double position_ms = 0.0;
+        Clock::time_point time;
+        Clock::time_point published;
+        bool paused = true;
+        bool buffering = false;
+    } playback_clock;
+    auto clockPredict = [&](Clock::time_point t) {
+        if (playback_clock.paused || playback_clock.buffering) return playback_clock.position_ms;
+        return playback_clock.position_ms + std::chrono::duration<double, std::milli>(t - playback_clock.time).count() * current_playback_rate;
+    };
+    auto publishClock = [&](Clock::time_point t) {
+        double age_ms = std::chrono::duration<double, std::milli>(t - playback_clock.time).count();
+        client->updateClock(playback_clock.position_ms, age_ms, playback_clock.buffering ? 0.0 : current_playback_rate, playback_clock.paused);
+        playback_clock.published = t;
+    };
+
     // Main loop - simplified (no Vulkan command buffers for main surface)
     bool running = true;
     bool needs_render = true;  // Render first frame
+    bool rendered_with_video = false;
     int slow_frame_count = 0;
     while (running && !client->isClosed()) {
         auto frame_start = Clock::now();
         auto now = frame_start;
-        bool activity_this_frame = false;
 
         // Process mpv events from event thread
-        for (const auto& ev : mpvEvents.drain()) {
+        TRACE_BEGIN("mpv events");
+        MpvEvent ev;
+        size_t mpv_event_count = 0;
+        while (mpvEvents.pop(ev)) {
+            mpv_event_count++;
             switch (ev.type) {
-            case MpvEvent::Type::Position:
-                mediaSessionThread.setPosition(static_cast<int64_t>(ev.value * 1000.0));
-                break;
             case MpvEvent::Type::Duration:
                 client->updateDuration(ev.value);
                 break;
             case MpvEvent::Type::Playing:
+                playback_clock.position_ms = clockPredict(ev.time);
+                playback_clock.time = ev.time;
+                playback_clock.paused = false;
+                playback_clock.buffering = false;
+                publishClock(now);
                 client->emitPlaying();
                 mediaSessionThread.setPlaybackState(PlaybackState::Playing);
                 break;
             case MpvEvent::Type::Paused:
+                playback_clock.position_ms = clockPredict(ev.time);
+                playback_clock.time = ev.time;
+                playback_clock.paused = ev.flag;
+                publishClock(now);
                 if (mpv->isPlaying()) {
                     if (ev.flag) {
                         client->emitPaused();
@@ -1051,6 +1239,8 @@ int main(int argc, char* argv[]) {
                 videoRenderThread.resetVideoReady();
 #endif
                 videoRenderer.setVisible(false);
+                playback_clock.paused = true;
+                publishClock(now);
                 client->emitFinished();
                 mediaSessionThread.setPlaybackState(PlaybackState::Stopped);
                 break;
@@ -1063,35 +1253,33 @@ int main(int argc, char* argv[]) {
                 videoRenderThread.resetVideoReady();
 #endif
                 videoRenderer.setVisible(false);
+                playback_clock.paused = true;
+                publishClock(now);
                 client->emitCanceled();
                 mediaSessionThread.setPlaybackState(PlaybackState::Stopped);
                 break;
             case MpvEvent::Type::Seeked:
+                playback_clock.position_ms = ev.value;
+                playback_clock.time = ev.time;
+                publishClock(now);
                 client->updatePosition(ev.value);
                 mediaSessionThread.setPosition(static_cast<int64_t>(ev.value * 1000.0));
                 mediaSessionThread.setRate(current_playback_rate);
                 mediaSessionThread.emitSeeked(static_cast<int64_t>(ev.value * 1000.0));
                 break;
             case MpvEvent::Type::Buffering:
+                playback_clock.position_ms = ev.value;
+                playback_clock.time = ev.time;
+                playback_clock.buffering = ev.flag;
+                publishClock(now);
                 mediaSessionThread.setPosition(static_cast<int64_t>(ev.value * 1000.0));
                 mediaSessionThread.setRate(ev.flag ? 0.0 : current_playback_rate);
                 break;
             case MpvEvent::Type::CoreIdle:
                 mediaSessionThread.setPosition(static_cast<int64_t>(ev.value * 1000.0));
                 break;
-            case MpvEvent::Type::BufferedRanges: {
-                std::string json = "[";
-                for (size_t i = 0; i < ev.ranges.size(); i++) {
-                    if (i > 0) json += ",";
-                    json += "{\"start\":" + std::to_string(ev.ranges[i].first) +
-                            ",\"end\":" + std::to_string(ev.ranges[i].second) + "}";
-                }
-                json += "]";
-                client->executeJS("if(window._nativeUpdateBufferedRanges)window._nativeUpdateBufferedRanges(" + json + ");");
-                break;
-            }
             case MpvEvent::Type::Error:
-                LOG_ERROR(LOG_MAIN, "Playback error: %s", ev.error.c_str());
+                LOG_ERROR(LOG_MAIN, "Playback error: %s", ev.error);
                 has_video = false;
                 video_ready = false;
 #if !defined(_WIN32) && !defined(__APPLE__)
@@ -1105,21 +1293,63 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        // Continuous values: at most one of each per tick (ignore a position
+        // sampled before a seek/buffering event already handled this tick)
+        MpvPosition pos;
+        if (mpvEvents.takePosition(pos) && pos.time >= playback_clock.time) {
+            bool drifted = std::abs(pos.ms - clockPredict(pos.time)) > CLOCK_DRIFT_TOLERANCE_MS;
+            playback_clock.position_ms = pos.ms;
+            playback_clock.time = pos.time;
+            if (drifted || now - playback_clock.published >= CLOCK_ANCHOR_INTERVAL) {
+                publishClock(now);
+            }
+            mediaSessionThread.setPosition(static_cast<int64_t>(pos.ms * 1000.0));
+        }
+        MpvBufferedRanges buffered;
+        if (mpvEvents.takeBufferedRanges(buffered)) {
+            std::string json = "[";
+            for (int i = 0; i < buffered.count; i++) {
+                if (i > 0) json += ",";
+                json += "{\"start\":" + std::to_string(buffered.ranges[i].start) +
+                        ",\"end\":" + std::to_string(buffered.ranges[i].end) + "}";
+            }
+            json += "]";
+            client->executeJS("if(window._nativeUpdateBufferedRanges)window._nativeUpdateBufferedRanges(" + json + ");");
+        }
+        TRACE_END("mpv events");
+
         if (!focus_set) {
             window_state.notifyFocusGained();
             focus_set = true;
         }
 
-        // Event-driven: wait for events when idle, poll when active
+        // Event-driven: poll while there is work, otherwise wait for an SDL
+        // event (input, window, or a wake from CEF paints, player commands,
+        // mpv events and video frames) or the next animation deadline.
+        // Playing video does not keep the loop busy.
         bool has_pending = browsers.anyHasPendingContent();
-        bool has_pending_cmds = false;
-        {
-            std::lock_guard<std::mutex> lock(cmd_mutex);
-            has_pending_cmds = !pending_cmds.empty();
+        bool has_pending_cmds = !player_cmds.empty();
+        int wait_ms = -1;  // no deadline
+        if (overlay_state == OverlayState::SPLASH || overlay_state == OverlayState::WAITING) {
+            auto remaining = std::chrono::duration<float>(OVERLAY_FADE_DELAY_SEC) - (now - overlay_fade_start);
+            wait_ms = (std::max)(0, static_cast<int>(std::ceil(
+                std::chrono::duration<float, std::milli>(remaining).count())));
+        }
+#if !defined(_WIN32) && !defined(__APPLE__)
+        if (browser_resize_pending) {
+            int resize_ms = (std::max)(0, static_cast<int>(std::ceil(
+                std::chrono::duration<float, std::milli>(next_browser_resize - now).count())));
+            wait_ms = wait_ms < 0 ? resize_ms : (std::min)(wait_ms, resize_ms);
+        }
+#endif
+        int hud_ms = hud.msUntilUpdate();
+        if (hud_ms >= 0) {
+            wait_ms = wait_ms < 0 ? hud_ms : (std::min)(wait_ms, hud_ms);
         }
         SDL_Event event;
         bool have_event;
-        if (needs_render || has_video || has_pending || has_pending_cmds || !paint_size_matched) {
+        auto idle_start = Clock::now();
+        if (needs_render || has_pending || has_pending_cmds || wait_ms == 0) {
             have_event = SDL_PollEvent(&event);
         } else {
 #ifdef __APPLE__
@@ -1129,31 +1359,37 @@ int main(int argc, char* argv[]) {
 
             // Re-check if CEF work generated content
             has_pending = browsers.anyHasPendingContent();
-            {
-                std::lock_guard<std::mutex> lock(cmd_mutex);
-                has_pending_cmds = !pending_cmds.empty();
-            }
+            has_pending_cmds = !player_cmds.empty();
             if (has_pending || has_pending_cmds) {
                 have_event = SDL_PollEvent(&event);
             } else {
                 // Wait using NSApplication's event loop - properly integrates
                 // Cocoa events, CFRunLoop sources, and Mojo IPC
-                waitForMacEvent();
+                TRACE_BEGIN("idle");
+                waitForMacEvent(wait_ms);
+                TRACE_END("idle");
                 have_event = SDL_PollEvent(&event);
             }
 #else
-            // Idle: block until SDL event (input, window, or CEF wake callback)
-            have_event = SDL_WaitEvent(&event);
+            // Idle: block until SDL event (input, window, or wake callback)
+            TRACE_BEGIN("idle");
+            have_event = wait_ms < 0 ? SDL_WaitEvent(&event) : SDL_WaitEventTimeout(&event, wait_ms);
+            TRACE_END("idle");
 #endif
         }
+        auto idle_time = Clock::now() - idle_start;
 
+        bool window_changed = false;
         while (have_event) {
+            if (event.type >= SDL_EVENT_WINDOW_FIRST && event.type <= SDL_EVENT_WINDOW_LAST) {
+                window_changed = true;  // expose, resize, scale etc. need a fresh frame
+            }
             switch (event.type) {
             case SDL_EVENT_QUIT:
                 running = false;
                 break;
 
-            // Input events - set activity flag and route through input stack
+            // Input events - route through input stack
             case SDL_EVENT_MOUSE_MOTION:
             case SDL_EVENT_MOUSE_BUTTON_DOWN:
             case SDL_EVENT_MOUSE_BUTTON_UP:
@@ -1163,8 +1399,6 @@ int main(int argc, char* argv[]) {
             case SDL_EVENT_FINGER_DOWN:
             case SDL_EVENT_FINGER_UP:
             case SDL_EVENT_FINGER_MOTION:
-                activity_this_frame = true;
-                [[fallthrough]];
             case SDL_EVENT_TEXT_INPUT:
                 input_stack.route(event);
                 // Handle special key combinations
@@ -1172,6 +1406,10 @@ int main(int argc, char* argv[]) {
                     if (event.key.key == SDLK_ESCAPE && !menu.isOpen()) {
                         running = false;
                     }
+                    if (event.key.key == SDLK_H &&
+                        (SDL_GetModState() & SDL_KMOD_CTRL) && (SDL_GetModState() & SDL_KMOD_SHIFT)) {
+                        hud.toggle();
+                    }
 #ifdef __APPLE__
                     // Cmd+Q to quit on macOS (no menu bar to provide this)
                     if (event.key.key == SDLK_Q && (SDL_GetModState() & SDL_KMOD_GUI)) {
@@ -1238,8 +1476,17 @@ int main(int argc, char* argv[]) {
                 int physical_w, physical_h;
                 SDL_GetWindowSizeInPixels(window, &physical_w, &physical_h);
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+                // Browsers follow on a debounced cadence; frames in between
+                // stretch their last paint over the new size
+                browser_resize_pending = true;
+                if (Clock::now() >= next_browser_resize) {
+                    applyBrowserResize();
+                }
+#else
                 // Resize all browsers and compositors via BrowserStack
-                browsers.resizeAll(current_width, current_height, physical_w, physical_h);
+                resizeBrowsers(current_width, current_height, physical_w, physical_h);
+#endif
 
 #ifdef __APPLE__
                 videoRenderer.resize(physical_w, physical_h);
@@ -1248,15 +1495,12 @@ int main(int argc, char* argv[]) {
                 wgl.resize(current_width, current_height);
                 video_needs_rerender = true;  // Force video rerender on resize
 #else
-                // Resize EGL context
-                egl.resize(physical_w, physical_h);
+                // Resize EGL context (on the thread that owns it)
+                compositor_thread.post([&egl, physical_w, physical_h]() { egl.resize(physical_w, physical_h); });
 
                 // Resize video layer on render thread (no-op for X11/OpenGL)
                 videoRenderThread.requestResize(physical_w, physical_h);
                 videoRenderer.setDestinationSize(current_width, current_height);
-
-                // Track resize time for paint matching
-                last_resize_time = Clock::now();
 #endif
                 break;
             }
@@ -1281,7 +1525,7 @@ int main(int argc, char* argv[]) {
                 SDL_GetWindowSizeInPixels(window, &physical_w, &physical_h);
 
                 // Resize all browsers and compositors, notify of scale change
-                browsers.resizeAll(new_logical_w, new_logical_h, physical_w, physical_h);
+                resizeBrowsers(new_logical_w, new_logical_h, physical_w, physical_h);
                 browsers.notifyAllScreenInfoChanged();
                 break;
             }
@@ -1297,29 +1541,47 @@ int main(int argc, char* argv[]) {
         App::DoWork();
 #endif
 
-        // Determine if we need to render this frame
-        needs_render = activity_this_frame || has_video || browsers.anyHasPendingContent() || overlay_state == OverlayState::FADING;
+        // Determine if we need to render this frame: only when a layer changed
+#if defined(_WIN32) || defined(__APPLE__)
+        // Video renders here; the mpv redraw callback wakes us for new frames
+        bool video_due = has_video && (videoRenderer.hasFrame() || video_needs_rerender);
+        // Keep compositing until CEF repaints at the new size
+        bool resize_due = !paint_size_matched;
+#else
+        // Video is presented by VideoRenderThread on its own surface
+        bool video_due = false;
+        // Trailing browser resize; its repaint wakes us like any other paint
+        if (browser_resize_pending && Clock::now() >= next_browser_resize) {
+            applyBrowserResize();
+        }
+        bool resize_due = false;
+#endif
+        needs_render = window_changed || video_due || browsers.anyHasPendingContent() || menu.needsRedraw() ||
+                       resize_due || overlay_state == OverlayState::FADING;
 
-        // Process player commands
+        // Process player commands. The batch is taken without a lock, so
+        // producers never wait on loadFile or metadata parsing.
         {
-            std::lock_guard<std::mutex> lock(cmd_mutex);
-            for (const auto& cmd : pending_cmds) {
-                if (cmd.cmd == "load") {
-                    double startSec = static_cast<double>(cmd.intArg) / 1000.0;
-                    LOG_INFO(LOG_MAIN, "playerLoad: %s start=%.1fs", cmd.url.c_str(), startSec);
+            TRACE_SCOPE("player commands");
+            player_cmds.drain(cmd_batch);
+            TRACE_COUNTER("pending commands", cmd_batch.size());
+            hud.recordQueues(mpv_event_count, cmd_batch.size());
+            for (const auto& cmd : cmd_batch) {
+                switch (cmd.type) {
+                case PlayerCommand::Type::Load: {
+                    double startSec = static_cast<double>(cmd.int_arg) / 1000.0;
+                    LOG_INFO(LOG_MAIN, "playerLoad: %s start=%.1fs", cmd.text.c_str(), startSec);
                     // Parse and set media session metadata
+                    ItemMetadata item = parseItemJson(cmd.metadata);
                     if (!cmd.metadata.empty() && cmd.metadata != "{}") {
-                        MediaMetadata meta = parseMetadataJson(cmd.metadata);
-                        LOG_DEBUG(LOG_MAIN, "metadata: title=%s artist=%s", meta.title.c_str(), meta.artist.c_str());
-                        mediaSessionThread.setMetadata(meta);
+                        LOG_DEBUG(LOG_MAIN, "metadata: title=%s artist=%s", item.media.title.c_str(), item.media.artist.c_str());
+                        mediaSessionThread.setMetadata(item.media);
                         // Apply normalization gain (ReplayGain) if present
-                        bool hasGain = false;
-                        double normGain = jsonGetDouble(cmd.metadata, "NormalizationGain", &hasGain);
-                        mpv->setNormalizationGain(hasGain ? normGain : 0.0);
+                        mpv->setNormalizationGain(item.has_normalization_gain ? item.normalization_gain : 0.0);
                     } else {
                         mpv->setNormalizationGain(0.0);  // Clear any previous gain
                     }
-                    if (mpv->loadFile(cmd.url, startSec)) {
+                    if (mpv->loadFile(cmd.text, startSec)) {
                         has_video = true;
                         videoRenderer.setVisible(true);
                         LOG_INFO(LOG_MAIN, "Video loaded, has_video=true");
@@ -1334,20 +1596,20 @@ int main(int argc, char* argv[]) {
                         }
 #endif
                         // Apply initial subtitle track if specified
-                        int subIdx = jsonGetIntDefault(cmd.metadata, "_subIdx", -1);
-                        if (subIdx >= 0) {
-                            mpv->setSubtitleTrack(subIdx);
+                        if (item.sub_idx >= 0) {
+                            mpv->setSubtitleTrack(item.sub_idx);
                         }
                         // Apply initial audio track if specified
-                        int audioIdx = jsonGetIntDefault(cmd.metadata, "_audioIdx", -1);
-                        if (audioIdx >= 0) {
-                            mpv->setAudioTrack(audioIdx);
+                        if (item.audio_idx >= 0) {
+                            mpv->setAudioTrack(item.audio_idx);
                         }
                         // mpv events will trigger state callbacks
                     } else {
                         client->emitError("Failed to load video");
                     }
-                } else if (cmd.cmd == "stop") {
+                    break;
+                }
+                case PlayerCommand::Type::Stop:
                     mpv->stop();
                     has_video = false;
                     video_ready = false;
@@ -1357,118 +1619,162 @@ int main(int argc, char* argv[]) {
 #endif
                     videoRenderer.setVisible(false);
                     // mpv END_FILE event will trigger finished callback
-                } else if (cmd.cmd == "pause") {
+                    break;
+                // mpv pause property change will trigger state callbacks
+                case PlayerCommand::Type::Pause:
                     mpv->pause();
-                    // mpv pause property change will trigger state callback
-                } else if (cmd.cmd == "play") {
+                    break;
+                case PlayerCommand::Type::Play:
                     mpv->play();
-                    // mpv pause property change will trigger state callback
-                } else if (cmd.cmd == "playpause") {
+                    break;
+                case PlayerCommand::Type::PlayPause:
                     if (mpv->isPaused()) {
                         mpv->play();
                     } else {
                         mpv->pause();
                     }
-                    // mpv pause property change will trigger state callback
-                } else if (cmd.cmd == "seek") {
-                    mpv->seek(static_cast<double>(cmd.intArg) / 1000.0);
-                } else if (cmd.cmd == "volume") {
-                    mpv->setVolume(cmd.intArg);
-                } else if (cmd.cmd == "mute") {
-                    mpv->setMuted(cmd.intArg != 0);
-                } else if (cmd.cmd == "speed") {
-                    double speed = cmd.intArg / 1000.0;
-                    mpv->setSpeed(speed);
-                } else if (cmd.cmd == "subtitle") {
-                    mpv->setSubtitleTrack(cmd.intArg);
-                } else if (cmd.cmd == "audio") {
-                    mpv->setAudioTrack(cmd.intArg);
-                } else if (cmd.cmd == "audioDelay") {
-                    if (!cmd.metadata.empty()) {
-                        try {
-                            double delay = std::stod(cmd.metadata);
-                            mpv->setAudioDelay(delay);
-                        } catch (...) {
-                            LOG_WARN(LOG_MAIN, "Invalid audioDelay value: %s", cmd.metadata.c_str());
-                        }
-                    }
-                } else if (cmd.cmd == "media_metadata") {
-                    MediaMetadata meta = parseMetadataJson(cmd.url);
+                    break;
+                case PlayerCommand::Type::Seek:
+                    mpv->seek(static_cast<double>(cmd.int_arg) / 1000.0);
+                    break;
+                case PlayerCommand::Type::Volume:
+                    mpv->setVolume(cmd.int_arg);
+                    break;
+                case PlayerCommand::Type::Mute:
+                    mpv->setMuted(cmd.int_arg != 0);
+                    break;
+                case PlayerCommand::Type::Speed:
+                    mpv->setSpeed(cmd.double_arg);
+                    break;
+                case PlayerCommand::Type::Subtitle:
+                    mpv->setSubtitleTrack(cmd.int_arg);
+                    break;
+                case PlayerCommand::Type::Audio:
+                    mpv->setAudioTrack(cmd.int_arg);
+                    break;
+                case PlayerCommand::Type::AudioDelay:
+                    mpv->setAudioDelay(cmd.double_arg);
+                    break;
+                case PlayerCommand::Type::MediaMetadata: {
+                    MediaMetadata meta = parseItemJson(cmd.text).media;
                     LOG_DEBUG(LOG_MAIN, "Media metadata: title=%s", meta.title.c_str());
                     mediaSessionThread.setMetadata(meta);
-                } else if (cmd.cmd == "media_position") {
-                    int64_t pos_us = static_cast<int64_t>(cmd.intArg) * 1000;
-                    mediaSessionThread.setPosition(pos_us);
-                } else if (cmd.cmd == "media_state") {
-                    if (cmd.url == "Playing") {
+                    break;
+                }
+                case PlayerCommand::Type::MediaPosition:
+                    mediaSessionThread.setPosition(static_cast<int64_t>(cmd.int_arg) * 1000);
+                    break;
+                case PlayerCommand::Type::MediaState:
+                    if (cmd.text == "Playing") {
                         mediaSessionThread.setPlaybackState(PlaybackState::Playing);
-                    } else if (cmd.url == "Paused") {
+                    } else if (cmd.text == "Paused") {
                         mediaSessionThread.setPlaybackState(PlaybackState::Paused);
                     } else {
                         mediaSessionThread.setPlaybackState(PlaybackState::Stopped);
                     }
-                } else if (cmd.cmd == "media_artwork") {
-                    LOG_DEBUG(LOG_MAIN, "Media artwork received: %.50s...", cmd.url.c_str());
-                    mediaSessionThread.setArtwork(cmd.url);
-                } else if (cmd.cmd == "media_queue") {
+                    break;
+                case PlayerCommand::Type::MediaArtwork:
+                    LOG_DEBUG(LOG_MAIN, "Media artwork received: %.50s...", cmd.text.c_str());
+                    mediaSessionThread.setArtwork(cmd.text);
+                    break;
+                case PlayerCommand::Type::MediaQueue:
                     // Decode flags: bit 0 = canNext, bit 1 = canPrev
-                    bool canNext = (cmd.intArg & 1) != 0;
-                    bool canPrev = (cmd.intArg & 2) != 0;
-                    mediaSessionThread.setCanGoNext(canNext);
-                    mediaSessionThread.setCanGoPrevious(canPrev);
-                } else if (cmd.cmd == "media_notify_rate") {
-                    // Rate was encoded as rate * 1000000
-                    double rate = static_cast<double>(cmd.intArg) / 1000000.0;
-                    current_playback_rate = rate;
-                    mediaSessionThread.setRate(rate);
-                } else if (cmd.cmd == "media_seeked") {
+                    mediaSessionThread.setCanGoNext((cmd.int_arg & 1) != 0);
+                    mediaSessionThread.setCanGoPrevious((cmd.int_arg & 2) != 0);
+                    break;
+                case PlayerCommand::Type::MediaNotifyRate:
+                    playback_clock.position_ms = clockPredict(now);
+                    playback_clock.time = now;
+                    current_playback_rate = cmd.double_arg;
+                    publishClock(now);
+                    mediaSessionThread.setRate(cmd.double_arg);
+                    break;
+                case PlayerCommand::Type::MediaSeeked:
                     // JS detected a seek - emit Seeked signal to media session
-                    int64_t pos_us = static_cast<int64_t>(cmd.intArg) * 1000;
-                    mediaSessionThread.emitSeeked(pos_us);
-                } else if (cmd.cmd == "media_action") {
+                    mediaSessionThread.emitSeeked(static_cast<int64_t>(cmd.int_arg) * 1000);
+                    break;
+                case PlayerCommand::Type::MediaAction: {
                     // Route media session control commands to JS playbackManager
-                    std::string js = "if(window._nativeHostInput) window._nativeHostInput(['" + cmd.url + "']);";
+                    std::string js = "if(window._nativeHostInput) window._nativeHostInput(['" + cmd.text + "']);";
                     client->executeJS(js);
-                } else if (cmd.cmd == "media_seek") {
+                    break;
+                }
+                case PlayerCommand::Type::MediaSeek: {
                     // Route media session seek to JS playbackManager
-                    std::string js = "if(window._nativeSeek) window._nativeSeek(" + std::to_string(cmd.intArg) + ");";
+                    std::string js = "if(window._nativeSeek) window._nativeSeek(" + std::to_string(cmd.int_arg) + ");";
                     client->executeJS(js);
-                } else if (cmd.cmd == "media_rate") {
+                    break;
+                }
+                case PlayerCommand::Type::MediaRate:
                     // Route media session rate change to JS player
-                    client->emitRateChanged(cmd.doubleArg);
+                    client->emitRateChanged(cmd.double_arg);
+                    break;
+                case PlayerCommand::Type::LoadError:
+                    // Saved server unreachable - bring up the server picker. Only
+                    // before the first load: HIDDEN is also the steady state, and
+                    // a later failure (reload while the server restarts) stays put
+                    if (!client->startupLoadPending() ||
+                        (overlay_state != OverlayState::SPLASH && overlay_state != OverlayState::HIDDEN)) {
+                        break;
+                    }
+                    LOG_INFO(LOG_MAIN, "Server load failed (%d), showing overlay", cmd.int_arg);
+                    if (!createOverlay(false)) {
+                        break;
+                    }
+                    overlay_state = OverlayState::SHOWING;
+                    overlay_browser_alpha = 1.0f;
+                    browsers.setAlpha("overlay", 1.0f);
+                    clear_color = 16.0f / 255.0f;
+                    needs_render = true;
+                    // Switch input from main browser to overlay
+                    window_state.remove(active_browser);
+                    active_browser->onFocusLost();
+                    input_stack.remove(browsers.getInputLayer("main"));
+                    input_stack.push(browsers.getInputLayer("overlay"));
+                    active_browser = browsers.getInputLayer("overlay");
+                    window_state.add(active_browser);
+                    active_browser->onFocusGained();
+                    break;
                 }
             }
-            pending_cmds.clear();
         }
 
         // Check for pending server URL from overlay
+        std::string server_url;
         {
-            std::lock_guard<std::mutex> lock(cmd_mutex);
-            if (!pending_server_url.empty()) {
-                std::string url = pending_server_url;
-                pending_server_url.clear();
-
-                // Only process if we're still showing the overlay form
-                // (ignore if already loading/fading from saved server)
-                if (overlay_state == OverlayState::SHOWING) {
-                    LOG_INFO(LOG_MAIN, "Loading server from overlay: %s", url.c_str());
-                    Settings::instance().setServerUrl(url);
-                    Settings::instance().save();
-                    client->loadUrl(url);
-                    overlay_state = OverlayState::WAITING;
-                    overlay_fade_start = now;
-                } else {
-                    LOG_DEBUG(LOG_MAIN, "Ignoring loadServer (overlay_state != SHOWING)");
-                }
+            std::lock_guard<std::mutex> lock(server_url_mutex);
+            server_url.swap(pending_server_url);
+        }
+        if (!server_url.empty()) {
+            // Only process if we're still showing the overlay form
+            // (ignore if already loading/fading from saved server)
+            if (overlay_state == OverlayState::SHOWING) {
+                LOG_INFO(LOG_MAIN, "Loading server from overlay: %s", server_url.c_str());
+                Settings::instance().setServerUrl(server_url);
+                Settings::instance().save();
+                client->loadUrl(server_url);
+                overlay_state = OverlayState::WAITING;
+                overlay_fade_start = now;
+            } else {
+                LOG_DEBUG(LOG_MAIN, "Ignoring loadServer (overlay_state != SHOWING)");
             }
         }
 
         // Update overlay state machine
-        if (overlay_state == OverlayState::WAITING) {
+        if (overlay_state == OverlayState::SPLASH) {
+            auto elapsed = std::chrono::duration<float>(now - overlay_fade_start).count();
+            if (elapsed >= OVERLAY_FADE_DELAY_SEC) {
+                overlay_state = OverlayState::HIDDEN;
+                clear_color = 0.0f;  // Switch to black background
+                needs_render = true;
+                LOG_DEBUG(LOG_OVERLAY, "State: SPLASH -> HIDDEN");
+            }
+        } else if (overlay_state == OverlayState::WAITING) {
             auto elapsed = std::chrono::duration<float>(now - overlay_fade_start).count();
             if (elapsed >= OVERLAY_FADE_DELAY_SEC) {
                 overlay_state = OverlayState::FADING;
                 clear_color = 0.0f;  // Switch to black background
+                needs_render = true;
                 // Switch input from overlay to main browser
                 window_state.remove(active_browser);
                 active_browser->onFocusLost();
@@ -1503,8 +1809,29 @@ int main(int argc, char* argv[]) {
             }
         }
 
-        // Menu overlay blending
+        // Perf HUD text refreshes on its own slow cadence
+        if (hud.updateDue()) {
+            MpvPlayer::PlaybackStats playback;
+            if (has_video) playback = mpv->getPlaybackStats();
+            hud.update(has_video ? &playback : nullptr);
+        }
+        needs_render = needs_render || hud.needsRedraw();
+
+        // Menu and HUD changes are drawn by their compositors below
         menu.clearRedraw();
+        hud.clearRedraw();
+
+        // Nothing changed: skip compositing and the swap. Video starting or
+        // stopping changes what shows under the browsers, so it counts.
+        if (!needs_render && has_video == rendered_with_video) {
+            stats::g_counters.main_loop.observe(
+                std::chrono::duration<double>(Clock::now() - frame_start - idle_time).count());
+            continue;
+        }
+        rendered_with_video = has_video;
+        browsers.markPaintsSubmitted();
+
+        TRACE_BEGIN("render");
 
         // Render video to subsurface/layer
 #ifdef __APPLE__
@@ -1523,6 +1850,8 @@ int main(int argc, char* argv[]) {
 
         // Flush and composite all browsers (back-to-front order)
         browsers.renderAll(current_width, current_height);
+        menu_compositor.render(menu, SDL_GetWindowPixelDensity(window), current_width, current_height);
+        hud_compositor.render(hud, SDL_GetWindowPixelDensity(window), current_width, current_height);
 #elif defined(_WIN32)
         // Windows: OpenGL mpv rendering directly to default framebuffer
         // Render video first (underneath the browser UI)
@@ -1537,31 +1866,40 @@ int main(int argc, char* argv[]) {
 
         // Flush and composite all browsers (back-to-front order)
         browsers.renderAll(current_width, current_height);
+        menu_compositor.render(menu, 1.0f, current_width, current_height);
+        hud_compositor.render(hud, 1.0f, current_width, current_height);
 
         frameContext.endFrame();
 #else
         // Linux: Unified rendering for Wayland and X11 using abstractions
         // Get physical dimensions for viewport (HiDPI)
         float frame_scale = SDL_GetWindowDisplayScale(window);
-        int viewport_w = static_cast<int>(current_width * frame_scale);
-        int viewport_h = static_cast<int>(current_height * frame_scale);
-        glViewport(0, 0, viewport_w, viewport_h);
+        CompositorThread::Frame frame;
+        frame.viewport_width = static_cast<int>(current_width * frame_scale);
+        frame.viewport_height = static_cast<int>(current_height * frame_scale);
 
         // Update video render dimensions (thread renders when frames available)
-        videoRenderThread.setDimensions(viewport_w, viewport_h);
+        videoRenderThread.setDimensions(frame.viewport_width, frame.viewport_height);
 
         // Clear (alpha depends on renderer type and whether video is ready)
-        frameContext.beginFrame(clear_color, videoRenderer.getClearAlpha(videoRenderThread.isVideoReady()));
-
-        // Flush and composite all browsers (back-to-front order)
-        browsers.renderAll(viewport_w, viewport_h);
-
-        frameContext.endFrame();
+        frame.clear_color = clear_color;
+        frame.clear_alpha = videoRenderer.getClearAlpha(videoRenderThread.isVideoReady());
+        frame.menu = MenuCompositor::snapshot(menu, frame_scale);
+        frame.hud = MenuCompositor::snapshot(hud, frame_scale);
+        frame.stretch = browser_resize_pending || !paint_size_matched;
+
+        // Uploads, compositing and the swap happen on the compositor thread
+        compositor_thread.submit(std::move(frame));
 #endif
-        // Log slow frames
+        TRACE_END("render");
+
+        // Log slow frames (busy time: the idle wait doesn't count)
         auto frame_end = Clock::now();
-        auto frame_ms = std::chrono::duration<double, std::milli>(frame_end - frame_start).count();
+        auto frame_ms = std::chrono::duration<double, std::milli>(frame_end - frame_start - idle_time).count();
+        hud.recordFrame(frame_ms);
+        stats::g_counters.main_loop.observe(frame_ms / 1000.0);
         if (frame_ms > 50.0 && has_video) {
+            TRACE_INSTANT("slow frame");
             slow_frame_count++;
             if (slow_frame_count <= 10) {
                 LOG_WARN(LOG_MAIN, "Slow frame: %.1fms (has_video=%d)", frame_ms, has_video);
@@ -1575,6 +1913,7 @@ int main(int argc, char* argv[]) {
 #endif
     mediaSessionThread.stop();
 #if !defined(_WIN32) && !defined(__APPLE__)
+    metricsServer.stop();
     videoRenderThread.stop();
 #endif
     mpvEvents.stop();
@@ -1582,16 +1921,23 @@ int main(int argc, char* argv[]) {
 
 #ifdef __APPLE__
     // macOS: simpler cleanup - CefShutdown handles browser cleanup
+    menu_compositor.cleanup();
+    hud_compositor.cleanup();
     browsers.cleanupCompositors();
     videoRenderer.cleanup();
     VideoStack::cleanupStatics();
     CefShutdown();
 #else
     // Windows/Linux: wait for async browser close before cleanup
+#ifndef _WIN32
+    compositor_thread.stop();  // GL context back on this thread for cleanup
+#endif
     browsers.closeAllBrowsers();
     while (!browsers.allBrowsersClosed()) {
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
+    menu_compositor.cleanup();
+    hud_compositor.cleanup();
     browsers.cleanupCompositors();
     videoRenderer.cleanup();
     VideoStack::cleanupStatics();
@@ -1602,6 +1948,7 @@ int main(int argc, char* argv[]) {
 #endif
     cefThread.shutdown();
 #endif
+    trace::stop();
     shutdownStderrCapture();
     shutdownLogging();
     if (current_cursor) {
@@ -0,0 +1,282 @@
+#include "metrics_server.h"
+#include "stats.h"
+#include "logging.h"
+#include "thread_policy.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr const char* PREFIX = "jellyfin_desktop_";
+
+uint64_t monotonicUs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+}
+
+template <typename... Args>
+void append(std::string& out, const char* fmt, Args... args) {
+    char buf[256];
+    int n = snprintf(buf, sizeof(buf), fmt, args...);
+    if (n > 0) out.append(buf, (std::min)(static_cast<size_t>(n), sizeof(buf) - 1));
+}
+
+void header(std::string& out, const char* name, const char* type, const char* help) {
+    append(out, "# HELP %s%s %s\n# TYPE %s%s %s\n", PREFIX, name, help, PREFIX, name, type);
+}
+
+void counter(std::string& out, const char* name, const char* help, uint64_t value) {
+    header(out, name, "counter", help);
+    append(out, "%s%s %llu\n", PREFIX, name, static_cast<unsigned long long>(value));
+}
+
+void gauge(std::string& out, const char* name, const char* help, double value) {
+    header(out, name, "gauge", help);
+    append(out, "%s%s %.15g\n", PREFIX, name, value);
+}
+
+void histogram(std::string& out, const char* name, const char* help, const stats::Histogram& h) {
+    header(out, name, "histogram", help);
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < stats::Histogram::BUCKETS; i++) {
+        cumulative += h.counts[i].load(std::memory_order_relaxed);
+        append(out, "%s%s_bucket{le=\"%g\"} %llu\n", PREFIX, name, stats::Histogram::BOUNDS[i],
+               static_cast<unsigned long long>(cumulative));
+    }
+    cumulative += h.counts[stats::Histogram::BUCKETS].load(std::memory_order_relaxed);
+    append(out, "%s%s_bucket{le=\"+Inf\"} %llu\n", PREFIX, name, static_cast<unsigned long long>(cumulative));
+    append(out, "%s%s_sum %.9f\n", PREFIX, name, h.sum_ns.load(std::memory_order_relaxed) / 1e9);
+    append(out, "%s%s_count %llu\n", PREFIX, name, static_cast<unsigned long long>(cumulative));
+}
+
+}  // namespace
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start(const std::string& socket_path, Sources sources) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(addr.sun_path)) {
+        LOG_ERROR(LOG_MAIN, "Metrics: invalid socket path '%s'", socket_path.c_str());
+        return false;
+    }
+    memcpy(addr.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    // Replace a socket left behind by a crashed run, but never a regular file
+    struct stat st;
+    if (lstat(socket_path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            LOG_ERROR(LOG_MAIN, "Metrics: %s exists and is not a socket", socket_path.c_str());
+            return false;
+        }
+        unlink(socket_path.c_str());
+    }
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        LOG_ERROR(LOG_MAIN, "Metrics: socket failed (errno %d)", errno);
+        return false;
+    }
+    // Owner-only; connects fail until listen(), so there is no window
+    bool bound = bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    if (!bound || chmod(socket_path.c_str(), 0600) < 0 || listen(listen_fd_, static_cast<int>(MAX_CLIENTS)) < 0) {
+        LOG_ERROR(LOG_MAIN, "Metrics: cannot listen on %s (errno %d)", socket_path.c_str(), errno);
+        close(listen_fd_);
+        listen_fd_ = -1;
+        if (bound) unlink(socket_path.c_str());
+        return false;
+    }
+
+    path_ = socket_path;
+    sources_ = std::move(sources);
+    reactor_.add(listen_fd_, EPOLLIN, [this]() { acceptClients(); });
+    reap_timer_ = reactor_.addTimer([this]() { reapClients(); });
+
+    running_ = true;
+    thread_ = std::thread(&MetricsServer::threadFunc, this);
+    LOG_INFO(LOG_MAIN, "Metrics: serving on %s", path_.c_str());
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (!running_) return;
+    running_ = false;
+
+    reactor_.stop();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    for (auto& entry : clients_) close(entry.first);
+    clients_.clear();
+    close(listen_fd_);
+    listen_fd_ = -1;
+    unlink(path_.c_str());
+    LOG_INFO(LOG_MAIN, "Metrics: stopped");
+}
+
+void MetricsServer::threadFunc() {
+    thread_policy::apply(thread_policy::Role::Metrics);
+    reactor_.run();
+}
+
+void MetricsServer::acceptClients() {
+    while (true) {
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                LOG_WARN(LOG_MAIN, "Metrics: accept failed (errno %d)", errno);
+            }
+            return;
+        }
+        // Scrapers are few; anything beyond that is dropped, not queued
+        if (clients_.size() >= MAX_CLIENTS || !reactor_.add(fd, EPOLLIN, [this, fd]() { serviceClient(fd); })) {
+            close(fd);
+            continue;
+        }
+        bool first = clients_.empty();
+        clients_[fd].deadline_us = monotonicUs() + CLIENT_TIMEOUT_US;
+        if (first) reactor_.setTimer(reap_timer_, clients_[fd].deadline_us);
+    }
+}
+
+void MetricsServer::serviceClient(int fd) {
+    auto it = clients_.find(fd);
+    if (it == clients_.end()) return;
+    Client& client = it->second;
+
+    if (client.response.empty()) {
+        // Read until the end of the request headers (or the client's EOF)
+        char buf[1024];
+        bool complete = false;
+        while (!complete) {
+            ssize_t n = read(fd, buf, sizeof(buf));
+            if (n > 0) {
+                client.request.append(buf, static_cast<size_t>(n));
+                complete = client.request.find("\r\n\r\n") != std::string::npos;
+                if (client.request.size() > MAX_REQUEST) {
+                    closeClient(fd);
+                    return;
+                }
+            } else if (n == 0) {
+                complete = true;
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            } else {
+                closeClient(fd);
+                return;
+            }
+        }
+        client.response = respond(client.request);
+        reactor_.modify(fd, EPOLLOUT);
+    }
+
+    while (client.sent < client.response.size()) {
+        ssize_t n = send(fd, client.response.data() + client.sent, client.response.size() - client.sent,
+                         MSG_NOSIGNAL);
+        if (n > 0) {
+            client.sent += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;  // EPOLLOUT brings us back
+        } else {
+            break;
+        }
+    }
+    closeClient(fd);
+}
+
+void MetricsServer::closeClient(int fd) {
+    reactor_.remove(fd);
+    close(fd);
+    clients_.erase(fd);
+}
+
+void MetricsServer::reapClients() {
+    uint64_t now = monotonicUs();
+    uint64_t next = Reactor::NO_DEADLINE;
+    for (auto it = clients_.begin(); it != clients_.end();) {
+        if (it->second.deadline_us <= now) {
+            reactor_.remove(it->first);
+            close(it->first);
+            it = clients_.erase(it);
+        } else {
+            next = (std::min)(next, it->second.deadline_us);
+            ++it;
+        }
+    }
+    reactor_.setTimer(reap_timer_, next);
+}
+
+std::string MetricsServer::respond(const std::string& request) const {
+    const char* status = "200 OK";
+    std::string body;
+    if (request.compare(0, 4, "GET ") == 0) {
+        body = render();
+    } else {
+        status = "405 Method Not Allowed";
+        body = "GET only\n";
+    }
+    std::string out;
+    append(out, "HTTP/1.0 %s\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                "Content-Length: %zu\r\nConnection: close\r\n\r\n", status, body.size());
+    return out + body;
+}
+
+std::string MetricsServer::render() const {
+    const auto& c = stats::g_counters;
+    std::string out;
+    out.reserve(4096);
+
+    counter(out, "cef_paints_total", "Software CEF paints, all browsers.", stats::read(c.cef_paints));
+    counter(out, "cef_gpu_paints_total", "Shared-texture (dmabuf) CEF paints.", stats::read(c.cef_gpu_paints));
+    counter(out, "upload_bytes_total", "Software CEF frame bytes uploaded to textures.",
+            stats::read(c.upload_bytes));
+    header(out, "upload_seconds", "summary", "Time spent in CEF frame uploads and dmabuf imports.");
+    append(out, "%supload_seconds_sum %.9f\n", PREFIX, stats::read(c.upload_ns) / 1e9);
+    append(out, "%supload_seconds_count %llu\n", PREFIX, static_cast<unsigned long long>(stats::read(c.uploads)));
+    counter(out, "player_commands_total", "Player commands drained by the main loop.",
+            stats::read(c.player_commands));
+    counter(out, "player_commands_coalesced_total", "Player commands superseded before running.",
+            stats::read(c.player_commands_coalesced));
+    counter(out, "media_session_commands_total", "Commands from MPRIS clients.",
+            stats::read(c.media_session_commands));
+    histogram(out, "main_loop_busy_seconds", "Main loop busy time per iteration, excluding the idle wait.",
+              c.main_loop);
+
+    gauge(out, "paint_buffer_bytes", "CEF paint double-buffer memory.",
+          static_cast<double>(stats::read(c.paint_buffer_bytes)));
+    gauge(out, "texture_bytes", "Compositor texture and PBO memory.",
+          static_cast<double>(stats::read(c.texture_bytes)));
+    if (sources_.mpv_event_queue_depth) {
+        gauge(out, "mpv_event_queue_depth", "Events waiting for the main loop.",
+              static_cast<double>(sources_.mpv_event_queue_depth()));
+    }
+    if (sources_.playback) {
+        // mpv resets these per file, so they are gauges rather than counters
+        MpvPlayer::PlaybackStats playback = sources_.playback();
+        gauge(out, "mpv_decoder_fps", "Estimated decoder output frame rate.", playback.decoder_fps);
+        gauge(out, "mpv_vo_dropped_frames", "Frames dropped by the video output, current file.",
+              static_cast<double>(playback.dropped_frames));
+        gauge(out, "mpv_decoder_dropped_frames", "Frames dropped by the decoder, current file.",
+              static_cast<double>(playback.decoder_drops));
+        gauge(out, "mpv_cache_seconds", "Demuxer cache ahead of the playback position.", playback.cache_seconds);
+        gauge(out, "mpv_buffering", "1 while playback is paused waiting for the cache.",
+              playback.buffering ? 1.0 : 0.0);
+    }
+    return out;
+}
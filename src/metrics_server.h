@@ -0,0 +1,61 @@
+#pragma once
+
+#include "player/mpv/mpv_player.h"
+#include "player/reactor.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Opt-in local metrics endpoint (Linux): serves the stats:: counters, the
+// main-loop histogram and mpv health in Prometheus text format over a
+// Unix-domain socket, one response per connection, e.g.
+//   curl --unix-socket /run/user/1000/jellyfin.sock http://localhost/metrics
+// Everything runs on its own reactor thread; a scrape never touches the main
+// loop. The socket is created 0600, so only the owning user can read it.
+class MetricsServer {
+public:
+    // Called on the metrics thread per scrape; must be thread-safe
+    struct Sources {
+        std::function<MpvPlayer::PlaybackStats()> playback;
+        std::function<size_t()> mpv_event_queue_depth;
+    };
+
+    MetricsServer() = default;
+    ~MetricsServer();
+
+    // Main thread. Fails if the path is taken by anything but a stale socket.
+    bool start(const std::string& socket_path, Sources sources);
+    void stop();
+
+private:
+    struct Client {
+        std::string request;
+        std::string response;
+        size_t sent = 0;
+        uint64_t deadline_us = 0;
+    };
+
+    void threadFunc();
+    void acceptClients();
+    void serviceClient(int fd);
+    void closeClient(int fd);
+    void reapClients();  // drop clients past their deadline, rearm the timer
+    std::string respond(const std::string& request) const;
+    std::string render() const;
+
+    std::string path_;
+    Sources sources_;
+    std::thread thread_;
+    bool running_ = false;  // main thread only
+
+    Reactor reactor_;        // listening socket, clients, reap timer, stop()
+    int listen_fd_ = -1;
+    int reap_timer_ = -1;
+    std::unordered_map<int, Client> clients_;  // thread only
+
+    static constexpr size_t MAX_CLIENTS = 8;
+    static constexpr size_t MAX_REQUEST = 8192;
+    static constexpr uint64_t CLIENT_TIMEOUT_US = 5000000;
+};
@@ -88,12 +88,14 @@ void initMacApplication() {
 // Wait for NSApplication events (integrates with both Cocoa and CFRunLoop)
 // Doesn't dequeue - just waits until an event is available, then returns
 // so SDL can process it
-void waitForMacEvent() {
+void waitForMacEvent(int timeout_ms) {
     @autoreleasepool {
-        // Wait indefinitely for any event, but don't dequeue it
+        // Wait for any event (or the timeout, if >= 0), but don't dequeue it
         // This pumps CFRunLoop (processing Mojo IPC) while waiting
+        NSDate* until = timeout_ms < 0 ? [NSDate distantFuture]
+                                       : [NSDate dateWithTimeIntervalSinceNow:timeout_ms / 1000.0];
         [NSApp nextEventMatchingMask:NSEventMaskAny
-                           untilDate:[NSDate distantFuture]
+                           untilDate:until
                               inMode:NSDefaultRunLoopMode
                              dequeue:NO];
         // Event stays in queue for SDL to process
@@ -0,0 +1,150 @@
+#include "player/artwork_cache.h"
+#include "logging.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+uint64_t fnv1a64(const std::string& data) {
+    uint64_t h = 14695981039346656037ull;
+    for (unsigned char c : data) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+const char* extensionForMime(const std::string& mime) {
+    if (mime == "image/png") return "png";
+    if (mime == "image/webp") return "webp";
+    if (mime == "image/gif") return "gif";
+    return "jpg";
+}
+
+} // namespace
+
+ArtworkCache& ArtworkCache::instance() {
+    static ArtworkCache instance;
+    return instance;
+}
+
+void ArtworkCache::init(const std::string& dir, size_t maxBytes) {
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec) {
+        LOG_WARN(LOG_MEDIA, "Artwork cache disabled: %s: %s", dir.c_str(), ec.message().c_str());
+        return;
+    }
+    dir_ = dir;
+    max_bytes_ = maxBytes;
+    LOG_DEBUG(LOG_MEDIA, "Artwork cache: %s (%zu KB budget)", dir_.c_str(), max_bytes_ / 1024);
+}
+
+std::string ArtworkCache::request(const std::string& url) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_url_ = url;
+    auto it = stored_.find(url);
+    return it != stored_.end() ? it->second : std::string();
+}
+
+bool ArtworkCache::isCurrent(const std::string& url) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return url == current_url_;
+}
+
+std::string ArtworkCache::store(const std::string& url, const std::string& bytes, const std::string& mimeType) {
+    if (!enabled() || bytes.empty()) return {};
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.%s",
+             static_cast<unsigned long long>(fnv1a64(bytes)), extensionForMime(mimeType));
+    fs::path path = fs::path(dir_) / name;
+
+    std::error_code ec;
+    if (fs::exists(path, ec)) {
+        // Same image seen before (other track, previous session): refresh LRU age
+        fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    } else {
+        // Write via temp + rename so readers never see a partial file
+        fs::path tmp = path;
+        tmp += ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            if (!out) {
+                LOG_WARN(LOG_MEDIA, "Artwork cache write failed: %s", tmp.string().c_str());
+                fs::remove(tmp, ec);
+                return {};
+            }
+        }
+        fs::rename(tmp, path, ec);
+        if (ec) {
+            LOG_WARN(LOG_MEDIA, "Artwork cache rename failed: %s", ec.message().c_str());
+            fs::remove(tmp, ec);
+            return {};
+        }
+        evict(name);
+    }
+
+    std::string fileUrl = "file://" + path.string();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stored_[url] = fileUrl;
+    return fileUrl;
+}
+
+void ArtworkCache::evict(const std::string& keep) {
+    struct Entry {
+        fs::path path;
+        fs::file_time_type mtime;
+        uintmax_t size;
+    };
+    std::vector<Entry> entries;
+    uintmax_t total = 0;
+
+    std::error_code ec;
+    for (const auto& de : fs::directory_iterator(dir_, ec)) {
+        if (!de.is_regular_file(ec)) continue;
+        Entry e{de.path(), de.last_write_time(ec), de.file_size(ec)};
+        if (ec) continue;
+        total += e.size;
+        entries.push_back(std::move(e));
+    }
+    if (total <= max_bytes_) return;
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+    for (const auto& e : entries) {
+        if (total <= max_bytes_) break;
+        if (e.path.filename() == keep) continue;
+        if (fs::remove(e.path, ec)) {
+            total -= e.size;
+            LOG_DEBUG(LOG_MEDIA, "Artwork cache evicted %s", e.path.filename().string().c_str());
+        }
+    }
+
+    // Forget session mappings whose files were evicted; stat outside the
+    // lock so request() on the media session thread never waits on disk
+    std::vector<std::pair<std::string, std::string>> mappings;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        mappings.assign(stored_.begin(), stored_.end());
+    }
+    std::vector<std::pair<std::string, std::string>> gone;
+    for (auto& mapping : mappings) {
+        if (!fs::exists(mapping.second.substr(7), ec)) gone.push_back(std::move(mapping));
+    }
+    if (gone.empty()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& mapping : gone) {
+        // Unless re-stored meanwhile
+        auto it = stored_.find(mapping.first);
+        if (it != stored_.end() && it->second == mapping.second && !fs::exists(it->second.substr(7), ec)) {
+            stored_.erase(it);
+        }
+    }
+}
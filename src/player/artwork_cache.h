@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Content-addressed on-disk cache for media session artwork.
+// Images are stored as <fnv1a64>.<ext> under the cache directory and
+// published to backends as file:// URLs, so the session bus never carries
+// image bytes. Least recently written files are evicted past the byte budget.
+class ArtworkCache {
+public:
+    static constexpr size_t DEFAULT_MAX_BYTES = 32 * 1024 * 1024;
+    static constexpr size_t MAX_IMAGE_BYTES = 8 * 1024 * 1024;
+
+    static ArtworkCache& instance();
+
+    void init(const std::string& dir, size_t maxBytes = DEFAULT_MAX_BYTES);
+    bool enabled() const { return !dir_.empty(); }
+
+    // Marks url as the current artwork. Returns its file:// URL if it was
+    // already stored this session, empty if it needs fetching.
+    std::string request(const std::string& url);
+    bool isCurrent(const std::string& url);
+
+    // Blocking file I/O; call from a worker thread.
+    // Writes the image (unless already present), evicts, returns file:// URL.
+    std::string store(const std::string& url, const std::string& bytes, const std::string& mimeType);
+
+private:
+    ArtworkCache() = default;
+    void evict(const std::string& keep);
+
+    std::string dir_;
+    size_t max_bytes_ = DEFAULT_MAX_BYTES;
+
+    std::mutex mutex_;
+    std::string current_url_;
+    std::unordered_map<std::string, std::string> stored_;  // source URL -> file:// URL
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// Fixed-capacity single-producer/single-consumer ring. push() from one thread,
+// pop() from another; no locks, no allocation after construction.
+template <typename T, size_t N>
+class SpscRing {
+    static_assert((N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    // Producer: false if the ring is full
+    bool push(const T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == N) return false;
+        slots_[head & (N - 1)] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: false if the ring is empty
+    bool pop(T& out) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return false;
+        out = slots_[tail & (N - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Any thread: items queued, approximate while either side is active
+    size_t size() const {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        return head_.load(std::memory_order_relaxed) - tail;
+    }
+
+private:
+    std::array<T, N> slots_{};
+    alignas(64) std::atomic<size_t> head_{0};  // Written by producer
+    alignas(64) std::atomic<size_t> tail_{0};  // Written by consumer
+};
+
+// Single-writer latest-value slot (seqlock). The writer overwrites freely; the
+// reader gets the most recent complete value, at most once per publish.
+template <typename T>
+class LatestValue {
+    static_assert(std::is_trivially_copyable_v<T>, "LatestValue requires a trivially copyable type");
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+public:
+    // Writer
+    void publish(const T& value) {
+        uint64_t words[WORDS] = {};
+        memcpy(words, &value, sizeof(T));
+        uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);  // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; i++) data_[i].store(words[i], std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Reader: false if nothing new since the last successful take(). Never waits:
+    // if the writer is mid-update, the value is picked up on the next call.
+    bool take(T& out) {
+        uint64_t seq = seq_.load(std::memory_order_acquire);
+        if (seq == taken_ || (seq & 1)) return false;
+        uint64_t words[WORDS];
+        for (size_t i = 0; i < WORDS; i++) words[i] = data_[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != seq) return false;
+        memcpy(&out, words, sizeof(T));
+        taken_ = seq;
+        return true;
+    }
+
+    // Reader: forget the pending value (e.g. on track change)
+    void discard() {
+        T ignored;
+        take(ignored);
+    }
+
+private:
+    std::atomic<uint64_t> seq_{0};
+    std::array<std::atomic<uint64_t>, WORDS> data_{};
+    uint64_t taken_ = 0;  // Reader only
+};
+
+// Unbounded multi-producer/single-consumer queue (a Treiber stack drained in
+// bulk). push() from any thread is one allocation and a CAS; the consumer
+// takes everything pending at once, oldest first.
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() = default;
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    ~MpscQueue() {
+        Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+        while (node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    // Any thread
+    void push(T value) {
+        Node* node = new Node{std::move(value), head_.load(std::memory_order_relaxed)};
+        while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+        }
+    }
+
+    // Any thread; a hint only, a concurrent push may follow immediately
+    bool empty() const { return head_.load(std::memory_order_relaxed) == nullptr; }
+
+    // Consumer: append every pending item to out in push order
+    template <typename Container>
+    void drain(Container& out) {
+        Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+        Node* oldest = nullptr;
+        while (node) {
+            Node* next = node->next;
+            node->next = oldest;
+            oldest = node;
+            node = next;
+        }
+        while (oldest) {
+            Node* next = oldest->next;
+            out.push_back(std::move(oldest->value));
+            delete oldest;
+            oldest = next;
+        }
+    }
+
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+    std::atomic<Node*> head_{nullptr};
+};
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include "player/media_session.h"
 
 class MacOSMediaBackend : public MediaSessionBackend {
@@ -9,7 +11,7 @@ public:
     ~MacOSMediaBackend() override;
 
     void setMetadata(const MediaMetadata& meta) override;
-    void setArtwork(const std::string& dataUri) override;
+    void setArtwork(const std::string& url) override;
     void setPlaybackState(PlaybackState state) override;
     void setPosition(int64_t position_us) override;
     void setVolume(double volume) override;
@@ -35,6 +37,10 @@ private:
     double rate_ = 1.0;
     bool pending_update_ = false;
     std::chrono::steady_clock::time_point last_position_update_;
+    // Bumped per setArtwork, on stop and teardown; in-flight fetches of an
+    // older generation are discarded (shared so they never touch this)
+    std::shared_ptr<std::atomic<uint64_t>> artwork_generation_ =
+        std::make_shared<std::atomic<uint64_t>>(0);
 
     // Private MediaRemote.framework function pointers
     typedef void (*SetNowPlayingVisibilityFunc)(void* origin, int visibility);
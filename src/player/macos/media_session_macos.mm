@@ -116,6 +116,7 @@ MacOSMediaBackend::MacOSMediaBackend(MediaSession* session) : session_(session)
 }
 
 MacOSMediaBackend::~MacOSMediaBackend() {
+    artwork_generation_->fetch_add(1);
     // Clear now playing info
     [MPNowPlayingInfoCenter defaultCenter].nowPlayingInfo = nil;
 
@@ -144,19 +145,8 @@ void MacOSMediaBackend::setMetadata(const MediaMetadata& meta) {
     updateNowPlayingInfo();
 }
 
-void MacOSMediaBackend::setArtwork(const std::string& dataUri) {
-    metadata_.art_data_uri = dataUri;
-
-    // Parse base64 data URI and create artwork
-    // Format: data:image/png;base64,<data>
-    size_t comma = dataUri.find(',');
-    if (comma == std::string::npos) return;
-
-    std::string base64Data = dataUri.substr(comma + 1);
-
-    // Decode base64
-    NSString* nsBase64 = [NSString stringWithUTF8String:base64Data.c_str()];
-    NSData* imageData = [[NSData alloc] initWithBase64EncodedString:nsBase64 options:0];
+// Any thread: MPNowPlayingInfoCenter is thread-safe
+static void publishArtwork(NSData* imageData) {
     if (!imageData) return;
 
     NSImage* image = [[NSImage alloc] initWithData:imageData];
@@ -174,6 +164,27 @@ void MacOSMediaBackend::setArtwork(const std::string& dataUri) {
     [MPNowPlayingInfoCenter defaultCenter].nowPlayingInfo = info;
 }
 
+void MacOSMediaBackend::setArtwork(const std::string& url) {
+    metadata_.art_file_url = url;
+    uint64_t generation = artwork_generation_->fetch_add(1) + 1;
+
+    NSURL* nsUrl = [NSURL URLWithString:[NSString stringWithUTF8String:url.c_str()]];
+    if (!nsUrl) return;
+    // file:// URL from the artwork cache: a local read
+    if (nsUrl.isFileURL) {
+        publishArtwork([NSData dataWithContentsOfURL:nsUrl]);
+        return;
+    }
+
+    // Remote URL (caching disabled): never block the media session thread
+    auto current = artwork_generation_;
+    NSURLSessionDataTask* task = [[NSURLSession sharedSession] dataTaskWithURL:nsUrl
+        completionHandler:^(NSData* data, NSURLResponse*, NSError*) {
+            if (data && current->load() == generation) publishArtwork(data);
+        }];
+    [task resume];
+}
+
 void MacOSMediaBackend::setPlaybackState(PlaybackState state) {
     state_ = state;
 
@@ -181,6 +192,7 @@ void MacOSMediaBackend::setPlaybackState(PlaybackState state) {
     if (state == PlaybackState::Stopped) {
         metadata_ = MediaMetadata{};
         position_us_ = 0;
+        artwork_generation_->fetch_add(1);  // drop in-flight artwork
         [MPNowPlayingInfoCenter defaultCenter].nowPlayingInfo = nil;
         [MPRemoteCommandCenter sharedCommandCenter].changePlaybackPositionCommand.enabled = NO;
     } else {
@@ -1,4 +1,5 @@
 #include "player/media_session.h"
+#include <algorithm>
 
 MediaSession::MediaSession(std::unique_ptr<MediaSessionBackend> backend) {
     if (backend) backends_.push_back(std::move(backend));
@@ -10,8 +11,8 @@ void MediaSession::setMetadata(const MediaMetadata& meta) {
     for (auto& b : backends_) b->setMetadata(meta);
 }
 
-void MediaSession::setArtwork(const std::string& dataUri) {
-    for (auto& b : backends_) b->setArtwork(dataUri);
+void MediaSession::setArtwork(const std::string& url) {
+    for (auto& b : backends_) b->setArtwork(url);
 }
 
 void MediaSession::setPlaybackState(PlaybackState state) {
@@ -54,3 +55,16 @@ int MediaSession::getFd() {
     }
     return -1;
 }
+
+bool MediaSession::wantsWrite() {
+    for (auto& b : backends_) {
+        if (b->getFd() >= 0) return b->wantsWrite();
+    }
+    return false;
+}
+
+uint64_t MediaSession::getTimeout() {
+    uint64_t deadline = UINT64_MAX;
+    for (auto& b : backends_) deadline = std::min(deadline, b->getTimeout());
+    return deadline;
+}
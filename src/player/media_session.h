@@ -15,7 +15,7 @@ struct MediaMetadata {
     int track_number = 0;
     int64_t duration_us = 0;
     std::string art_url;       // Jellyfin URL
-    std::string art_data_uri;  // base64 data URI after fetch
+    std::string art_file_url;  // file:// URL from the artwork cache
     MediaType media_type = MediaType::Unknown;
 };
 
@@ -25,7 +25,7 @@ class MediaSessionBackend {
 public:
     virtual ~MediaSessionBackend() = default;
     virtual void setMetadata(const MediaMetadata& meta) = 0;
-    virtual void setArtwork(const std::string& dataUri) = 0;  // Update artwork separately
+    virtual void setArtwork(const std::string& url) = 0;  // Update artwork separately (file:// URL)
     virtual void setPlaybackState(PlaybackState state) = 0;
     virtual void setPosition(int64_t position_us) = 0;
     virtual void setVolume(double volume) = 0;
@@ -33,8 +33,10 @@ public:
     virtual void setCanGoPrevious(bool can) = 0;
     virtual void setRate(double rate) = 0;
     virtual void emitSeeked(int64_t /*position_us*/) {}
-    virtual void update() = 0;  // Called from event loop to process events
+    virtual void update() = 0;  // Called from event loop to process events and flush batched signals
     virtual int getFd() = 0;    // File descriptor for poll, -1 if none
+    virtual bool wantsWrite() { return false; }           // Poll getFd() for writability too
+    virtual uint64_t getTimeout() { return UINT64_MAX; }  // Absolute CLOCK_MONOTONIC us to call update() by
 };
 
 class MediaSession {
@@ -43,7 +45,7 @@ public:
     ~MediaSession();
 
     void setMetadata(const MediaMetadata& meta);
-    void setArtwork(const std::string& dataUri);  // Update artwork separately (async fetch)
+    void setArtwork(const std::string& url);  // Update artwork separately (async fetch)
     void setPlaybackState(PlaybackState state);
     void setPosition(int64_t position_us);
     void setVolume(double volume);
@@ -55,6 +57,8 @@ public:
     // Called from event loop
     void update();
     int getFd();  // File descriptor for poll, -1 if none
+    bool wantsWrite();     // Of the getFd() backend
+    uint64_t getTimeout(); // Earliest backend deadline, UINT64_MAX if none
 
     // Control callbacks (set by main.cpp)
     std::function<void()> onPlay;
@@ -1,11 +1,12 @@
 #include "media_session_thread.h"
 #include "logging.h"
-#include <chrono>
+#include "thread_policy.h"
+#include "trace.h"
+#include <algorithm>
+#include <iterator>
 
 #if !defined(_WIN32) && !defined(__APPLE__)
-#include <sys/eventfd.h>
-#include <poll.h>
-#include <unistd.h>
+#include <sys/epoll.h>
 #endif
 
 MediaSessionThread::~MediaSessionThread() {
@@ -16,10 +17,7 @@ void MediaSessionThread::start(MediaSession* session) {
     session_ = session;
 
 #if !defined(_WIN32) && !defined(__APPLE__)
-    event_fd_ = eventfd(0, EFD_NONBLOCK);
-    if (event_fd_ < 0) {
-        LOG_ERROR(LOG_MEDIA, "eventfd creation failed");
-    }
+    reactor_.setWakeHandler([this]() { service(); });
 #endif
 
     running_.store(true);
@@ -31,218 +29,229 @@ void MediaSessionThread::stop() {
     if (!running_.load()) return;
 
     running_.store(false);
-    wake();  // Wake thread so it can exit
+#if !defined(_WIN32) && !defined(__APPLE__)
+    reactor_.stop();
+#else
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    cv_.notify_one();
+#endif
 
     if (thread_.joinable()) {
         thread_.join();
     }
 
-#if !defined(_WIN32) && !defined(__APPLE__)
-    if (event_fd_ >= 0) {
-        close(event_fd_);
-        event_fd_ = -1;
-    }
-#endif
-
     LOG_INFO(LOG_MEDIA, "media session thread stopped");
 }
 
 void MediaSessionThread::wake() {
 #if !defined(_WIN32) && !defined(__APPLE__)
-    if (event_fd_ >= 0) {
-        uint64_t val = 1;
-        [[maybe_unused]] auto _ = write(event_fd_, &val, sizeof(val));
-    }
+    reactor_.wake();
 #else
     cv_.notify_one();
 #endif
 }
 
-void MediaSessionThread::enqueue(MediaSessionCmd cmd) {
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        queue_.push(std::move(cmd));
-    }
-    wake();
+bool MediaSessionThread::markDirty(MediaSessionState::Field field) {
+    constexpr uint32_t positionBit = 1u << MediaSessionState::Position;
+    uint32_t bit = 1u << field;
+    // Only the first non-position change since the last drain needs a wakeup;
+    // position mostly rides along with it (setPosition wakes on coarse drift)
+    bool needWake = bit != positionBit && (pending_.dirty & ~positionBit) == 0;
+    pending_.dirty |= bit;
+    pending_.order[field] = ++seq_;
+    return needWake;
 }
 
 void MediaSessionThread::setPlaybackState(PlaybackState state) {
-    MediaSessionCmd cmd;
-    cmd.type = MediaSessionCmd::Type::SetPlaybackState;
-    cmd.state = state;
-    enqueue(std::move(cmd));
+    bool needWake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.state = state;
+        needWake = markDirty(MediaSessionState::PlaybackStateField);
+    }
+    if (needWake) wake();
 }
 
 void MediaSessionThread::setPosition(int64_t position_us) {
-    MediaSessionCmd cmd;
-    cmd.type = MediaSessionCmd::Type::SetPosition;
-    cmd.position_us = position_us;
-    enqueue(std::move(cmd));
+    bool needWake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.position_us = position_us;
+        // No wakeup already in flight and the last published position is
+        // a coarse interval stale (or playback jumped backwards)
+        bool idle = (pending_.dirty & ~(1u << MediaSessionState::Position)) == 0;
+        int64_t drift = position_us - position_drained_us_;
+        needWake = idle && (drift >= POSITION_WAKE_US || drift < 0);
+        markDirty(MediaSessionState::Position);
+        if (needWake) position_drained_us_ = position_us;  // one wakeup per interval
+    }
+    if (needWake) wake();
 }
 
 void MediaSessionThread::setRate(double rate) {
-    MediaSessionCmd cmd;
-    cmd.type = MediaSessionCmd::Type::SetRate;
-    cmd.rate = rate;
-    enqueue(std::move(cmd));
+    bool needWake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.rate = rate;
+        needWake = markDirty(MediaSessionState::Rate);
+    }
+    if (needWake) wake();
 }
 
 void MediaSessionThread::setMetadata(const MediaMetadata& meta) {
-    MediaSessionCmd cmd;
-    cmd.type = MediaSessionCmd::Type::SetMetadata;
-    cmd.metadata = meta;
-    enqueue(std::move(cmd));
+    bool needWake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.metadata = meta;
+        needWake = markDirty(MediaSessionState::Metadata);
+    }
+    if (needWake) wake();
 }
 
 void MediaSessionThread::emitSeeked(int64_t position_us) {
-    MediaSessionCmd cmd;
-    cmd.type = MediaSessionCmd::Type::EmitSeeked;
-    cmd.position_us = position_us;
-    enqueue(std::move(cmd));
+    bool needWake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.seeked_us = position_us;
+        needWake = markDirty(MediaSessionState::Seeked);
+    }
+    if (needWake) wake();
 }
 
 void MediaSessionThread::setArtwork(const std::string& url) {
-    MediaSessionCmd cmd;
-    cmd.type = MediaSessionCmd::Type::SetArtwork;
-    cmd.artwork_url = url;
-    enqueue(std::move(cmd));
+    bool needWake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.artwork_url = url;
+        needWake = markDirty(MediaSessionState::Artwork);
+    }
+    if (needWake) wake();
 }
 
 void MediaSessionThread::setCanGoNext(bool can) {
-    MediaSessionCmd cmd;
-    cmd.type = MediaSessionCmd::Type::SetCanGoNext;
-    cmd.flag = can;
-    enqueue(std::move(cmd));
+    bool needWake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.can_go_next = can;
+        needWake = markDirty(MediaSessionState::CanGoNext);
+    }
+    if (needWake) wake();
 }
 
 void MediaSessionThread::setCanGoPrevious(bool can) {
-    MediaSessionCmd cmd;
-    cmd.type = MediaSessionCmd::Type::SetCanGoPrevious;
-    cmd.flag = can;
-    enqueue(std::move(cmd));
+    bool needWake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.can_go_previous = can;
+        needWake = markDirty(MediaSessionState::CanGoPrevious);
+    }
+    if (needWake) wake();
 }
 
-void MediaSessionThread::threadFunc() {
-#if !defined(_WIN32) && !defined(__APPLE__)
-    // Linux: fully event-driven with poll() on D-Bus fd + eventfd
-    int dbus_fd = session_->getFd();
+void MediaSessionThread::applyPending() {
+    MediaSessionState work;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!pending_.dirty) return;
+        // Move out only what changed; clean fields keep their last value
+        work.dirty = pending_.dirty;
+        std::copy(std::begin(pending_.order), std::end(pending_.order), std::begin(work.order));
+        work.state = pending_.state;
+        work.position_us = pending_.position_us;
+        if (work.dirty & (1u << MediaSessionState::Position)) position_drained_us_ = work.position_us;
+        work.rate = pending_.rate;
+        work.seeked_us = pending_.seeked_us;
+        work.can_go_next = pending_.can_go_next;
+        work.can_go_previous = pending_.can_go_previous;
+        if (work.dirty & (1u << MediaSessionState::Metadata))
+            work.metadata = std::move(pending_.metadata);
+        if (work.dirty & (1u << MediaSessionState::Artwork))
+            work.artwork_url = std::move(pending_.artwork_url);
+        pending_.dirty = 0;
+    }
 
-    while (running_.load()) {
-        // Process all pending commands
-        std::queue<MediaSessionCmd> work;
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            work.swap(queue_);
-        }
+    // Apply dirty fields in the order they were last written, so e.g. a
+    // Stopped that follows new metadata still clears it
+    MediaSessionState::Field fields[MediaSessionState::FieldCount];
+    int count = 0;
+    for (int f = 0; f < MediaSessionState::FieldCount; f++) {
+        if (work.dirty & (1u << f)) fields[count++] = static_cast<MediaSessionState::Field>(f);
+    }
+    std::sort(fields, fields + count, [&](auto a, auto b) { return work.order[a] < work.order[b]; });
 
-        while (!work.empty()) {
-            const auto& cmd = work.front();
-            switch (cmd.type) {
-                case MediaSessionCmd::Type::SetPlaybackState:
-                    session_->setPlaybackState(cmd.state);
-                    break;
-                case MediaSessionCmd::Type::SetPosition:
-                    session_->setPosition(cmd.position_us);
-                    break;
-                case MediaSessionCmd::Type::SetRate:
-                    session_->setRate(cmd.rate);
-                    break;
-                case MediaSessionCmd::Type::SetMetadata:
-                    session_->setMetadata(cmd.metadata);
-                    break;
-                case MediaSessionCmd::Type::EmitSeeked:
-                    session_->emitSeeked(cmd.position_us);
-                    break;
-                case MediaSessionCmd::Type::SetArtwork:
-                    session_->setArtwork(cmd.artwork_url);
-                    break;
-                case MediaSessionCmd::Type::SetCanGoNext:
-                    session_->setCanGoNext(cmd.flag);
-                    break;
-                case MediaSessionCmd::Type::SetCanGoPrevious:
-                    session_->setCanGoPrevious(cmd.flag);
-                    break;
-            }
-            work.pop();
+    for (int i = 0; i < count; i++) {
+        switch (fields[i]) {
+            case MediaSessionState::PlaybackStateField:
+                session_->setPlaybackState(work.state);
+                break;
+            case MediaSessionState::Position:
+                session_->setPosition(work.position_us);
+                break;
+            case MediaSessionState::Rate:
+                session_->setRate(work.rate);
+                break;
+            case MediaSessionState::Metadata:
+                session_->setMetadata(work.metadata);
+                break;
+            case MediaSessionState::Seeked:
+                session_->emitSeeked(work.seeked_us);
+                break;
+            case MediaSessionState::Artwork:
+                session_->setArtwork(work.artwork_url);
+                break;
+            case MediaSessionState::CanGoNext:
+                session_->setCanGoNext(work.can_go_next);
+                break;
+            case MediaSessionState::CanGoPrevious:
+                session_->setCanGoPrevious(work.can_go_previous);
+                break;
+            case MediaSessionState::FieldCount:
+                break;
         }
+    }
+}
 
-        // Poll on D-Bus fd and eventfd
-        struct pollfd fds[2];
-        int nfds = 0;
-
-        if (dbus_fd >= 0) {
-            fds[nfds].fd = dbus_fd;
-            fds[nfds].events = POLLIN;
-            nfds++;
-        }
-        if (event_fd_ >= 0) {
-            fds[nfds].fd = event_fd_;
-            fds[nfds].events = POLLIN;
-            nfds++;
-        }
+void MediaSessionThread::service() {
+    TRACE_SCOPE("mediaSessionUpdate");
+    // Apply latest state before handling D-Bus requests so property reads
+    // (Position in particular) see current values
+    applyPending();
 
-        if (nfds > 0) {
-            poll(fds, nfds, 100);  // 100ms timeout for shutdown check
+    // Process incoming D-Bus messages and flush batched property changes
+    session_->update();
 
-            // Drain eventfd if signaled
-            for (int i = 0; i < nfds; i++) {
-                if (fds[i].fd == event_fd_ && (fds[i].revents & POLLIN)) {
-                    uint64_t val;
-                    [[maybe_unused]] auto _ = read(event_fd_, &val, sizeof(val));
-                }
-            }
-        }
+#if !defined(_WIN32) && !defined(__APPLE__)
+    // sd-bus may have queued output or be waiting on a method call reply
+    if (bus_fd_ >= 0) {
+        reactor_.modify(bus_fd_, session_->wantsWrite() ? EPOLLIN | EPOLLOUT : EPOLLIN);
+        reactor_.setTimer(bus_timer_, session_->getTimeout());
+    }
+#endif
+}
 
-        // Process any incoming D-Bus messages
-        session_->update();
+void MediaSessionThread::threadFunc() {
+    thread_policy::apply(thread_policy::Role::MediaSession);
+#if !defined(_WIN32) && !defined(__APPLE__)
+    // Linux: sleeps until D-Bus traffic, a D-Bus deadline, wake() or stop()
+    int fd = session_->getFd();
+    if (fd >= 0 && reactor_.add(fd, EPOLLIN, [this]() { service(); })) {
+        bus_fd_ = fd;
+        bus_timer_ = reactor_.addTimer([this]() { service(); });
     }
+    service();
+    reactor_.run();
 #else
-    // macOS/Windows: CV-based with timeout for incoming message check
-    while (running_.load()) {
-        // Process all pending commands
-        std::queue<MediaSessionCmd> work;
+    // macOS/Windows: commands arrive through platform callbacks, so the
+    // thread only has to apply state changes
+    while (true) {
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            work.swap(queue_);
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [this] { return !running_.load() || pending_.dirty != 0; });
         }
-
-        while (!work.empty()) {
-            const auto& cmd = work.front();
-            switch (cmd.type) {
-                case MediaSessionCmd::Type::SetPlaybackState:
-                    session_->setPlaybackState(cmd.state);
-                    break;
-                case MediaSessionCmd::Type::SetPosition:
-                    session_->setPosition(cmd.position_us);
-                    break;
-                case MediaSessionCmd::Type::SetRate:
-                    session_->setRate(cmd.rate);
-                    break;
-                case MediaSessionCmd::Type::SetMetadata:
-                    session_->setMetadata(cmd.metadata);
-                    break;
-                case MediaSessionCmd::Type::EmitSeeked:
-                    session_->emitSeeked(cmd.position_us);
-                    break;
-                case MediaSessionCmd::Type::SetArtwork:
-                    session_->setArtwork(cmd.artwork_url);
-                    break;
-                case MediaSessionCmd::Type::SetCanGoNext:
-                    session_->setCanGoNext(cmd.flag);
-                    break;
-                case MediaSessionCmd::Type::SetCanGoPrevious:
-                    session_->setCanGoPrevious(cmd.flag);
-                    break;
-            }
-            work.pop();
-        }
-
-        // Check for incoming messages
-        session_->update();
-
-        // Wait for command or timeout
-        std::unique_lock lock(mutex_);
-        cv_.wait_for(lock, std::chrono::milliseconds(16));
+        if (!running_.load()) break;
+        service();
     }
 #endif
 }
@@ -3,32 +3,41 @@
 #include <thread>
 #include <atomic>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <cstdint>
 #include <condition_variable>
 #include "media_session.h"
 
-// Commands that can be sent to media session thread
-struct MediaSessionCmd {
-    enum class Type {
-        SetPlaybackState,
-        SetPosition,
-        SetRate,
-        SetMetadata,
-        EmitSeeked,
-        SetArtwork,
-        SetCanGoNext,
-        SetCanGoPrevious
+#if !defined(_WIN32) && !defined(__APPLE__)
+#include "reactor.h"
+#endif
+
+// Desired media session state. Producers overwrite fields and mark them
+// dirty; the thread applies only the latest value of each dirty field.
+struct MediaSessionState {
+    enum Field : uint8_t {
+        PlaybackStateField,
+        Position,
+        Rate,
+        Metadata,
+        Seeked,
+        Artwork,
+        CanGoNext,
+        CanGoPrevious,
+        FieldCount
     };
 
-    Type type;
     PlaybackState state = PlaybackState::Stopped;
     int64_t position_us = 0;
     double rate = 1.0;
     MediaMetadata metadata;
+    int64_t seeked_us = 0;
     std::string artwork_url;
-    bool flag = false;  // for canGoNext/canGoPrevious
+    bool can_go_next = false;
+    bool can_go_previous = false;
+
+    uint32_t dirty = 0;              // bit per Field
+    uint32_t order[FieldCount] = {}; // sequence of last write, preserves cross-field ordering
 };
 
 // Runs media session updates on dedicated thread
@@ -40,7 +49,7 @@ public:
     void start(MediaSession* session);
     void stop();
 
-    // Queue commands (non-blocking)
+    // Update desired state (non-blocking, coalesced)
     void setPlaybackState(PlaybackState state);
     void setPosition(int64_t position_us);
     void setRate(double rate);
@@ -51,19 +60,31 @@ public:
     void setCanGoPrevious(bool can);
 
 private:
+    // Position alone wakes the thread once it has drifted this far, so
+    // Now Playing elapsed time stays fresh without a wakeup per update
+    static constexpr int64_t POSITION_WAKE_US = 1000000;
+
     void threadFunc();
-    void enqueue(MediaSessionCmd cmd);
-    void wake();  // Wake thread to process commands
+    void service();  // Apply pending state, then process the backend
+    void applyPending();
+    // Marks field dirty under mutex_; returns true if the thread needs a wakeup
+    bool markDirty(MediaSessionState::Field field);
+    void wake();  // Wake thread to apply state
 
     MediaSession* session_ = nullptr;
     std::thread thread_;
     std::atomic<bool> running_{false};
 
     std::mutex mutex_;
-    std::queue<MediaSessionCmd> queue_;
-    std::condition_variable cv_;  // For non-Linux platforms
+    MediaSessionState pending_;
+    uint32_t seq_ = 0;
+    int64_t position_drained_us_ = 0;  // position last handed to the backend
 
 #if !defined(_WIN32) && !defined(__APPLE__)
-    int event_fd_ = -1;  // eventfd for Linux poll() wakeup
+    Reactor reactor_;     // D-Bus fd, D-Bus timeout, wake()/stop()
+    int bus_fd_ = -1;     // thread only
+    int bus_timer_ = -1;  // thread only
+#else
+    std::condition_variable cv_;
 #endif
 };
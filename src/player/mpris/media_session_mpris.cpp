@@ -1,5 +1,6 @@
 #include "player/mpris/media_session_mpris.h"
 #include <cstring>
+#include <poll.h>
 #include "logging.h"
 
 // D-Bus object path
@@ -262,11 +263,11 @@ static int prop_get_metadata(sd_bus* bus, const char* path, const char* interfac
     }
 
     // Art URL
-    if (!meta.art_data_uri.empty()) {
+    if (!meta.art_file_url.empty()) {
         sd_bus_message_open_container(reply, 'e', "sv");
         sd_bus_message_append(reply, "s", "mpris:artUrl");
         sd_bus_message_open_container(reply, 'v', "s");
-        sd_bus_message_append(reply, "s", meta.art_data_uri.c_str());
+        sd_bus_message_append(reply, "s", meta.art_file_url.c_str());
         sd_bus_message_close_container(reply);
         sd_bus_message_close_container(reply);
     }
@@ -401,8 +402,8 @@ void MprisBackend::setMetadata(const MediaMetadata& meta) {
     emitPropertiesChanged(MPRIS_PLAYER_IFACE, "Metadata");
 }
 
-void MprisBackend::setArtwork(const std::string& dataUri) {
-    metadata_.art_data_uri = dataUri;
+void MprisBackend::setArtwork(const std::string& url) {
+    metadata_.art_file_url = url;
     emitPropertiesChanged(MPRIS_PLAYER_IFACE, "Metadata");
 }
 
@@ -426,8 +427,8 @@ void MprisBackend::setPlaybackState(PlaybackState state) {
 
     // Emit all capability-related properties when state changes
     // MPRIS clients need to know when controls become available/unavailable
-    sd_bus_emit_properties_changed(bus_, MPRIS_PATH, MPRIS_PLAYER_IFACE,
-        "PlaybackStatus", "CanPlay", "CanPause", "CanSeek", "CanControl", "Metadata", nullptr);
+    for (const char* prop : {"PlaybackStatus", "CanPlay", "CanPause", "CanSeek", "CanControl", "Metadata"})
+        emitPropertiesChanged(MPRIS_PLAYER_IFACE, prop);
 }
 
 void MprisBackend::setPosition(int64_t position_us) {
@@ -488,12 +489,23 @@ void MprisBackend::update() {
     do {
         r = sd_bus_process(bus_, nullptr);
     } while (r > 0);
+    flushPropertiesChanged();
 }
 
 int MprisBackend::getFd() {
     return bus_ ? sd_bus_get_fd(bus_) : -1;
 }
 
+bool MprisBackend::wantsWrite() {
+    return bus_ && (sd_bus_get_events(bus_) & POLLOUT);
+}
+
+uint64_t MprisBackend::getTimeout() {
+    uint64_t usec;
+    if (!bus_ || sd_bus_get_timeout(bus_, &usec) < 0) return UINT64_MAX;
+    return usec;
+}
+
 const char* MprisBackend::getPlaybackStatus() const {
     switch (state_) {
         case PlaybackState::Playing: return "Playing";
@@ -504,7 +516,26 @@ const char* MprisBackend::getPlaybackStatus() const {
 
 void MprisBackend::emitPropertiesChanged(const char* interface, const char* property) {
     if (!bus_) return;
-    sd_bus_emit_properties_changed(bus_, MPRIS_PATH, interface, property, nullptr);
+    // Batched until the next update() so a tick produces one signal per interface
+    for (auto& batch : pending_props_) {
+        if (strcmp(batch.interface, interface) != 0) continue;
+        for (const char* p : batch.properties) {
+            if (strcmp(p, property) == 0) return;
+        }
+        batch.properties.push_back(property);
+        return;
+    }
+    pending_props_.push_back({interface, {property}});
+}
+
+void MprisBackend::flushPropertiesChanged() {
+    for (auto& batch : pending_props_) {
+        if (batch.properties.empty()) continue;
+        batch.properties.push_back(nullptr);
+        sd_bus_emit_properties_changed_strv(bus_, MPRIS_PATH, batch.interface,
+                                            const_cast<char**>(batch.properties.data()));
+        batch.properties.clear();
+    }
 }
 
 std::unique_ptr<MediaSessionBackend> createMprisBackend(MediaSession* session) {
@@ -2,6 +2,7 @@
 
 #include "player/media_session.h"
 #include <systemd/sd-bus.h>
+#include <vector>
 
 class MprisBackend : public MediaSessionBackend {
 public:
@@ -9,7 +10,7 @@ public:
     ~MprisBackend() override;
 
     void setMetadata(const MediaMetadata& meta) override;
-    void setArtwork(const std::string& dataUri) override;
+    void setArtwork(const std::string& url) override;
     void setPlaybackState(PlaybackState state) override;
     void setPosition(int64_t position_us) override;
     void setVolume(double volume) override;
@@ -19,6 +20,8 @@ public:
     void emitSeeked(int64_t position_us) override;  // Emit Seeked signal when user seeks
     void update() override;
     int getFd() override;
+    bool wantsWrite() override;
+    uint64_t getTimeout() override;
 
     // Property getters (called from D-Bus vtable)
     const char* getPlaybackStatus() const;
@@ -31,7 +34,15 @@ public:
     MediaSession* session() { return session_; }
 
 private:
+    // Queue a property for the next batched PropertiesChanged signal
     void emitPropertiesChanged(const char* interface, const char* property);
+    void flushPropertiesChanged();
+
+    struct PendingProperties {
+        const char* interface;
+        std::vector<const char*> properties;  // static strings, deduplicated
+    };
+    std::vector<PendingProperties> pending_props_;
 
     MediaSession* session_;
     sd_bus* bus_ = nullptr;
@@ -20,6 +20,15 @@ public:
     using ErrorCallback = std::function<void(const std::string& error)>;
     using WakeupCallback = std::function<void()>;
 
+    // Decoder and cache health, for diagnostics. Safe from any thread.
+    struct PlaybackStats {
+        double decoder_fps = 0;       // estimated-vf-fps
+        int64_t dropped_frames = 0;   // frame-drop-count (VO)
+        int64_t decoder_drops = 0;    // decoder-frame-drop-count
+        double cache_seconds = 0;     // demuxer-cache-duration
+        bool buffering = false;       // paused-for-cache
+    };
+
     virtual ~MpvPlayer() = default;
 
     // Playback control
@@ -45,6 +54,7 @@ public:
     virtual bool hasFrame() const = 0;
     virtual bool isHdr() const = 0;
     virtual bool needsRedraw() const = 0;
+    virtual PlaybackStats getPlaybackStats() const = 0;
     virtual void clearRedrawFlag() = 0;
 
     // Events
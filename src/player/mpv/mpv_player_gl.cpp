@@ -8,6 +8,7 @@
 #include <clocale>
 #include <cmath>
 #include "logging.h"
+#include "shader_cache.h"
 
 MpvPlayerGL::MpvPlayerGL() = default;
 
@@ -189,6 +190,13 @@ bool MpvPlayerGL::init(GLContext* gl) {
     mpv_set_option_string(mpv_, "ytdl", "no");
     mpv_set_option_string(mpv_, "audio-fallback-to-null", "yes");
 
+    // libplacebo keeps its GL program binaries here, so playback after the
+    // first launch links cached programs instead of compiling GLSL
+    std::string shader_cache_dir = ShaderCache::instance().mpvDir();
+    if (!shader_cache_dir.empty()) {
+        mpv_set_option_string(mpv_, "gpu-shader-cache-dir", shader_cache_dir.c_str());
+    }
+
     if (mpv_initialize(mpv_) < 0) {
         LOG_ERROR(LOG_MPV, "mpv_initialize failed");
         return false;
@@ -365,6 +373,20 @@ bool MpvPlayerGL::isPaused() const {
     return paused != 0;
 }
 
+MpvPlayer::PlaybackStats MpvPlayerGL::getPlaybackStats() const {
+    PlaybackStats stats;
+    if (!mpv_) return stats;
+    // Unavailable properties (nothing playing) leave the defaults
+    mpv_get_property(mpv_, "estimated-vf-fps", MPV_FORMAT_DOUBLE, &stats.decoder_fps);
+    mpv_get_property(mpv_, "frame-drop-count", MPV_FORMAT_INT64, &stats.dropped_frames);
+    mpv_get_property(mpv_, "decoder-frame-drop-count", MPV_FORMAT_INT64, &stats.decoder_drops);
+    mpv_get_property(mpv_, "demuxer-cache-duration", MPV_FORMAT_DOUBLE, &stats.cache_seconds);
+    int buffering = 0;
+    mpv_get_property(mpv_, "paused-for-cache", MPV_FORMAT_FLAG, &buffering);
+    stats.buffering = buffering != 0;
+    return stats;
+}
+
 bool MpvPlayerGL::hasFrame() const {
     if (!render_ctx_) return false;
     return (mpv_render_context_update(render_ctx_) & MPV_RENDER_UPDATE_FRAME) != 0;
@@ -50,6 +50,7 @@ public:
     double getDuration() const override;
     double getSpeed() const override;
     bool isPaused() const override;
+    PlaybackStats getPlaybackStats() const override;
     bool isPlaying() const override { return playing_; }
     bool needsRedraw() const override { return needs_redraw_.load(); }
     void clearRedrawFlag() override { needs_redraw_ = false; }
@@ -5,6 +5,7 @@
 #include <clocale>
 #include <cmath>
 #include "logging.h"
+#include "shader_cache.h"
 
 MpvPlayerVk::MpvPlayerVk() = default;
 
@@ -182,6 +183,13 @@ bool MpvPlayerVk::init(VulkanContext* vk, VideoSurface* subsurface) {
     // Prevents blocking/crashes on audio errors (like jellyfin-desktop)
     mpv_set_option_string(mpv_, "audio-fallback-to-null", "yes");
 
+    // libplacebo keeps compiled SPIR-V and the Vulkan pipeline cache here,
+    // so the first video after a restart doesn't stall on pipeline creation
+    std::string shader_cache_dir = ShaderCache::instance().mpvDir();
+    if (!shader_cache_dir.empty()) {
+        mpv_set_option_string(mpv_, "gpu-shader-cache-dir", shader_cache_dir.c_str());
+    }
+
     // HDR output configuration
     bool use_hdr = subsurface_ && subsurface_->isHdr();
     if (use_hdr) {
@@ -424,6 +432,20 @@ bool MpvPlayerVk::isPaused() const {
     return paused != 0;
 }
 
+MpvPlayer::PlaybackStats MpvPlayerVk::getPlaybackStats() const {
+    PlaybackStats stats;
+    if (!mpv_) return stats;
+    // Unavailable properties (nothing playing) leave the defaults
+    mpv_get_property(mpv_, "estimated-vf-fps", MPV_FORMAT_DOUBLE, &stats.decoder_fps);
+    mpv_get_property(mpv_, "frame-drop-count", MPV_FORMAT_INT64, &stats.dropped_frames);
+    mpv_get_property(mpv_, "decoder-frame-drop-count", MPV_FORMAT_INT64, &stats.decoder_drops);
+    mpv_get_property(mpv_, "demuxer-cache-duration", MPV_FORMAT_DOUBLE, &stats.cache_seconds);
+    int buffering = 0;
+    mpv_get_property(mpv_, "paused-for-cache", MPV_FORMAT_FLAG, &buffering);
+    stats.buffering = buffering != 0;
+    return stats;
+}
+
 bool MpvPlayerVk::hasFrame() const {
     if (!render_ctx_) return false;
     uint64_t flags = mpv_render_context_update(render_ctx_);
@@ -1,80 +1,85 @@
 #include "mpv_event_thread.h"
 #include "mpv/mpv_player.h"
 #include "logging.h"
+#include "thread_policy.h"
+#include "trace.h"
+#include <cstdio>
 
 MpvEventThread::~MpvEventThread() {
     stop();
 }
 
-void MpvEventThread::start(MpvPlayer* player) {
+void MpvEventThread::start(MpvPlayer* player, std::function<void()> on_ready) {
     player_ = player;
+    on_ready_ = std::move(on_ready);
 
     // Set up callbacks that queue events instead of executing directly
+    // (all run on this thread, so the ring has a single producer)
     player_->setPositionCallback([this](double ms) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        pending_.push_back(MpvEvent{MpvEvent::Type::Position, ms});
+        auto now = std::chrono::steady_clock::now();
+        position_.publish(MpvPosition{ms, now});
+        // time-pos changes every video frame; the consumer only needs it
+        // for drift checks and the media session
+        if (now - last_position_wake_ >= POSITION_WAKE_INTERVAL) {
+            last_position_wake_ = now;
+            ready_ = true;
+        }
     });
 
     player_->setDurationCallback([this](double ms) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        pending_.push_back(MpvEvent{MpvEvent::Type::Duration, ms});
+        push(MpvEvent{MpvEvent::Type::Duration, ms});
     });
 
     player_->setPlayingCallback([this]() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        pending_.push_back(MpvEvent{MpvEvent::Type::Playing});
+        push(MpvEvent{MpvEvent::Type::Playing});
     });
 
     player_->setStateCallback([this](bool paused) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        pending_.push_back(MpvEvent{MpvEvent::Type::Paused, 0, paused});
+        push(MpvEvent{MpvEvent::Type::Paused, 0, paused});
     });
 
     player_->setFinishedCallback([this]() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        pending_.push_back(MpvEvent{MpvEvent::Type::Finished});
+        push(MpvEvent{MpvEvent::Type::Finished});
     });
 
     player_->setCanceledCallback([this]() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        pending_.push_back(MpvEvent{MpvEvent::Type::Canceled});
+        push(MpvEvent{MpvEvent::Type::Canceled});
     });
 
     player_->setSeekedCallback([this](double ms) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        pending_.push_back(MpvEvent{MpvEvent::Type::Seeked, ms});
+        push(MpvEvent{MpvEvent::Type::Seeked, ms});
     });
 
     player_->setBufferingCallback([this](bool buffering, double ms) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        pending_.push_back(MpvEvent{MpvEvent::Type::Buffering, ms, buffering});
+        push(MpvEvent{MpvEvent::Type::Buffering, ms, buffering});
     });
 
     player_->setCoreIdleCallback([this](bool idle, double ms) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        pending_.push_back(MpvEvent{MpvEvent::Type::CoreIdle, ms, idle});
+        push(MpvEvent{MpvEvent::Type::CoreIdle, ms, idle});
     });
 
     player_->setBufferedRangesCallback([this](const std::vector<MpvPlayer::BufferedRange>& ranges) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        MpvEvent ev;
-        ev.type = MpvEvent::Type::BufferedRanges;
+        MpvBufferedRanges value;
         for (const auto& r : ranges) {
-            ev.ranges.emplace_back(r.start, r.end);
+            if (value.count == MpvBufferedRanges::MAX_RANGES) break;
+            value.ranges[value.count++] = {r.start, r.end};
         }
-        pending_.push_back(std::move(ev));
+        buffered_ranges_.publish(value);
+        ready_ = true;
     });
 
     player_->setErrorCallback([this](const std::string& error) {
-        std::lock_guard<std::mutex> lock(mutex_);
         MpvEvent ev;
         ev.type = MpvEvent::Type::Error;
-        ev.error = error;
-        pending_.push_back(std::move(ev));
+        snprintf(ev.error, sizeof(ev.error), "%s", error.c_str());
+        push(ev);
     });
 
-    // Set wakeup callback to notify our CV when mpv has events
+    // mpv's wakeup callback only signals; events are drained on this thread
     player_->setWakeupCallback([this]() { wake(); });
+#if !defined(_WIN32) && !defined(__APPLE__)
+    reactor_.setWakeHandler([this]() { processBatch(); });
+#endif
 
     running_.store(true);
     thread_ = std::thread(&MpvEventThread::threadFunc, this);
@@ -84,32 +89,86 @@ void MpvEventThread::start(MpvPlayer* player) {
 void MpvEventThread::stop() {
     if (!running_.load()) return;
     running_.store(false);
-    cv_.notify_one();  // Wake thread so it can exit
+#if !defined(_WIN32) && !defined(__APPLE__)
+    reactor_.stop();
+#else
+    {
+        std::lock_guard<std::mutex> lock(cv_mutex_);
+        wake_pending_ = true;
+    }
+    cv_.notify_one();
+#endif
     if (thread_.joinable()) {
         thread_.join();
     }
     LOG_INFO(LOG_MPV, "mpv event thread stopped");
 }
 
-std::vector<MpvEvent> MpvEventThread::drain() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::vector<MpvEvent> result;
-    result.swap(pending_);
-    return result;
+void MpvEventThread::push(const MpvEvent& ev) {
+    MpvEvent stamped = ev;
+    stamped.time = std::chrono::steady_clock::now();
+    if (overflow_size_.load(std::memory_order_acquire) > 0 || !events_.push(stamped)) {
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        if (overflow_.empty()) {
+            LOG_WARN(LOG_MPV, "mpv event ring full, spilling events until the main thread catches up");
+        }
+        overflow_.push_back(stamped);
+        overflow_size_.store(overflow_.size(), std::memory_order_release);
+    }
+    ready_ = true;
+}
+
+bool MpvEventThread::pop(MpvEvent& ev) {
+    if (events_.pop(ev)) return true;
+    // Ring drained: anything spilled is newer than all of it
+    if (overflow_size_.load(std::memory_order_acquire) == 0) return false;
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    if (overflow_.empty()) return false;
+    ev = overflow_.front();
+    overflow_.pop_front();
+    overflow_size_.store(overflow_.size(), std::memory_order_release);
+    return true;
 }
 
 void MpvEventThread::wake() {
+#if !defined(_WIN32) && !defined(__APPLE__)
+    reactor_.wake();
+#else
+    {
+        std::lock_guard<std::mutex> lock(cv_mutex_);
+        wake_pending_ = true;
+    }
     cv_.notify_one();
+#endif
 }
 
-void MpvEventThread::threadFunc() {
-    while (running_.load()) {
+void MpvEventThread::processBatch() {
+    {
+        TRACE_SCOPE("processEvents");
         player_->processEvents();
+    }
+    if (ready_) {
+        ready_ = false;
+        if (on_ready_) on_ready_();
+    }
+}
 
-        // Wait for mpv wakeup callback or shutdown
-        std::unique_lock lock(cv_mutex_);
-        cv_.wait_for(lock, std::chrono::milliseconds(100), [this] {
-            return !running_.load();
-        });
+void MpvEventThread::threadFunc() {
+    thread_policy::apply(thread_policy::Role::MpvEvents);
+    // Events may have arrived before the wakeup callback was installed
+    processBatch();
+#if !defined(_WIN32) && !defined(__APPLE__)
+    // Sleeps until mpv signals or stop(); no timeout
+    reactor_.run();
+#else
+    while (true) {
+        {
+            std::unique_lock lock(cv_mutex_);
+            cv_.wait(lock, [this] { return wake_pending_; });
+            wake_pending_ = false;
+        }
+        if (!running_.load()) break;
+        processBatch();
     }
+#endif
 }
@@ -4,16 +4,21 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
-#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <deque>
 #include <functional>
-#include <string>
+#include "lock_free.h"
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+#include "reactor.h"
+#endif
 
 class MpvPlayer;
 
-// Event types that mpv thread queues for main thread
+// Discrete events that mpv thread queues for main thread (in order)
 struct MpvEvent {
     enum class Type {
-        Position,
         Duration,
         Playing,
         Paused,
@@ -22,15 +27,27 @@ struct MpvEvent {
         Seeked,
         Buffering,
         CoreIdle,
-        BufferedRanges,
         Error
     };
 
-    Type type;
+    Type type = Type::Playing;
     double value = 0;           // position/duration in ms
     bool flag = false;          // paused/buffering/idle
-    std::string error;          // error message
-    std::vector<std::pair<int64_t, int64_t>> ranges;  // buffered ranges
+    char error[128] = {};       // error message
+    std::chrono::steady_clock::time_point time;  // when mpv reported it
+};
+
+// Continuous values: only the latest matters, published without queueing
+struct MpvPosition {
+    double ms = 0;
+    std::chrono::steady_clock::time_point time;  // when mpv reported it
+};
+
+struct MpvBufferedRanges {
+    static constexpr int MAX_RANGES = 16;
+    struct Range { int64_t start; int64_t end; };  // ticks (100ns units)
+    int count = 0;
+    Range ranges[MAX_RANGES];
 };
 
 // Runs mpv event processing on dedicated thread
@@ -39,26 +56,52 @@ public:
     MpvEventThread() = default;
     ~MpvEventThread();
 
-    // Start thread - takes ownership of event processing
-    void start(MpvPlayer* player);
+    // Start thread - takes ownership of event processing. on_ready runs on
+    // the event thread once per batch that queued events or changed values
+    // (position wakes are throttled to POSITION_WAKE_INTERVAL).
+    void start(MpvPlayer* player, std::function<void()> on_ready = nullptr);
 
     // Stop thread
     void stop();
 
-    // Main thread calls this to get pending events (swaps buffers)
-    std::vector<MpvEvent> drain();
+    // Main thread: next discrete event, false when none are pending
+    bool pop(MpvEvent& ev);
+    // Any thread: events waiting for the main thread (approximate)
+    size_t queueDepth() const { return events_.size() + overflow_size_.load(std::memory_order_relaxed); }
+
+    // Main thread: latest continuous values, false if unchanged since last call
+    bool takePosition(MpvPosition& pos) { return position_.take(pos); }
+    bool takeBufferedRanges(MpvBufferedRanges& ranges) { return buffered_ranges_.take(ranges); }
 
 private:
     void threadFunc();
+    void processBatch();
     void wake();
+    void push(const MpvEvent& ev);
+
+    static constexpr auto POSITION_WAKE_INTERVAL = std::chrono::milliseconds(250);
 
     MpvPlayer* player_ = nullptr;
+    std::function<void()> on_ready_;
+    bool ready_ = false;  // event thread only
+    std::chrono::steady_clock::time_point last_position_wake_;
     std::thread thread_;
     std::atomic<bool> running_{false};
 
-    std::mutex mutex_;
-    std::vector<MpvEvent> pending_;
+    SpscRing<MpvEvent, 256> events_;
+    // Discrete events are never dropped: when the ring is full they queue
+    // here, and keep doing so until the main thread drains it, so order holds
+    std::mutex overflow_mutex_;
+    std::deque<MpvEvent> overflow_;
+    std::atomic<size_t> overflow_size_{0};  // written under overflow_mutex_
+    LatestValue<MpvPosition> position_;
+    LatestValue<MpvBufferedRanges> buffered_ranges_;
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+    Reactor reactor_;  // wakes on mpv's wakeup callback or stop()
+#else
     std::mutex cv_mutex_;
     std::condition_variable cv_;
+    bool wake_pending_ = false;  // protected by cv_mutex_
+#endif
 };
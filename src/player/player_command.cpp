@@ -0,0 +1,130 @@
+#include "player_command.h"
+#include "logging.h"
+#include "stats.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+namespace {
+
+using Type = PlayerCommand::Type;
+
+struct MessageName {
+    const char* name;
+    Type type;
+};
+
+constexpr MessageName MESSAGE_NAMES[] = {
+    {"load", Type::Load},
+    {"stop", Type::Stop},
+    {"pause", Type::Pause},
+    {"play", Type::Play},
+    {"playpause", Type::PlayPause},
+    {"seek", Type::Seek},
+    {"volume", Type::Volume},
+    {"mute", Type::Mute},
+    {"speed", Type::Speed},
+    {"subtitle", Type::Subtitle},
+    {"audio", Type::Audio},
+    {"audioDelay", Type::AudioDelay},
+    {"loadError", Type::LoadError},
+    {"media_metadata", Type::MediaMetadata},
+    {"media_position", Type::MediaPosition},
+    {"media_state", Type::MediaState},
+    {"media_artwork", Type::MediaArtwork},
+    {"media_queue", Type::MediaQueue},
+    {"media_notify_rate", Type::MediaNotifyRate},
+    {"media_seeked", Type::MediaSeeked},
+};
+
+// Latest value wins within a run of the batch
+bool coalesces(Type type) {
+    return type == Type::Volume || type == Type::Seek || type == Type::Speed ||
+           type == Type::MediaPosition;
+}
+
+// Ends a run: values before a new file or a stop don't carry over
+bool startsRun(Type type) {
+    return type == Type::Load || type == Type::Stop;
+}
+
+// Sent by the OS media controls (MPRIS, Now Playing)
+bool fromMediaSession(Type type) {
+    return type == Type::MediaAction || type == Type::MediaSeek || type == Type::MediaRate;
+}
+
+}  // namespace
+
+bool PlayerCommand::fromMessage(const std::string& cmd, const std::string& arg, int intArg,
+                                const std::string& metadata, PlayerCommand& out) {
+    auto it = std::find_if(std::begin(MESSAGE_NAMES), std::end(MESSAGE_NAMES),
+                           [&](const MessageName& m) { return cmd == m.name; });
+    if (it == std::end(MESSAGE_NAMES)) {
+        LOG_WARN(LOG_MAIN, "Unknown player command: %s", cmd.c_str());
+        return false;
+    }
+
+    out = PlayerCommand(it->type, arg, intArg);
+    switch (it->type) {
+        case Type::Load:
+            out.metadata = metadata;
+            break;
+        case Type::Speed:
+            out.double_arg = intArg / 1000.0;
+            break;
+        case Type::MediaNotifyRate:
+            // Rate was encoded as rate * 1000000
+            out.double_arg = intArg / 1000000.0;
+            break;
+        case Type::AudioDelay: {
+            char* end = nullptr;
+            out.double_arg = strtod(metadata.c_str(), &end);
+            if (metadata.empty() || *end != '\0') {
+                LOG_WARN(LOG_MAIN, "Invalid audioDelay value: %s", metadata.c_str());
+                return false;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return true;
+}
+
+void PlayerCommandQueue::drain(std::vector<PlayerCommand>& out) {
+    out.clear();
+    batch_.clear();
+    queue_.drain(batch_);
+    if (batch_.empty()) return;
+
+    // Walk newest to oldest so the first of each coalescing type seen is
+    // the one kept
+    std::vector<bool> keep(batch_.size(), true);
+    uint32_t seen = 0;  // bit per Type
+    size_t media_session = 0;
+    for (size_t i = batch_.size(); i-- > 0;) {
+        Type type = batch_[i].type;
+        if (fromMediaSession(type)) media_session++;
+        if (startsRun(type)) {
+            seen = 0;
+        } else if (coalesces(type)) {
+            uint32_t bit = 1u << static_cast<int>(type);
+            if (seen & bit) keep[i] = false;
+            seen |= bit;
+        }
+    }
+
+    out.reserve(batch_.size());
+    for (int pass = 0; pass < 2; pass++) {
+        bool display = pass == 1;
+        for (size_t i = 0; i < batch_.size(); i++) {
+            if (keep[i] && batch_[i].isDisplayUpdate() == display) {
+                out.push_back(std::move(batch_[i]));
+            }
+        }
+    }
+
+    stats::add(stats::g_counters.player_commands, batch_.size());
+    stats::add(stats::g_counters.player_commands_coalesced, batch_.size() - out.size());
+    stats::add(stats::g_counters.media_session_commands, media_session);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "lock_free.h"
+
+// A player command for the main loop. Messages are typed where they are
+// queued, so the main loop dispatches on an enum instead of comparing strings.
+struct PlayerCommand {
+    enum class Type : uint8_t {
+        // Playback: run first, in arrival order
+        Load,
+        Stop,
+        Pause,
+        Play,
+        PlayPause,
+        Seek,
+        Volume,
+        Mute,
+        Speed,
+        Subtitle,
+        Audio,
+        AudioDelay,
+        LoadError,
+        MediaAction,  // media session control, routed to the web player
+        MediaSeek,
+        MediaRate,
+        // Media session display updates: run after playback commands
+        MediaMetadata,
+        MediaPosition,
+        MediaState,
+        MediaArtwork,
+        MediaQueue,
+        MediaNotifyRate,
+        MediaSeeked,
+    };
+
+    Type type = Type::Stop;
+    std::string text;       // url, action, state, or metadata JSON
+    int int_arg = 0;
+    double double_arg = 0;  // speed, rate, audio delay
+    std::string metadata;   // item JSON for Load
+
+    PlayerCommand() = default;
+    PlayerCommand(Type type, std::string text = {}, int int_arg = 0, double double_arg = 0)
+        : type(type), text(std::move(text)), int_arg(int_arg), double_arg(double_arg) {}
+
+    // Typed form of a browser player message; false (and logged) if unknown
+    static bool fromMessage(const std::string& cmd, const std::string& arg, int intArg,
+                            const std::string& metadata, PlayerCommand& out);
+
+    bool isDisplayUpdate() const { return type >= Type::MediaMetadata; }
+};
+
+// Player commands from the browser and media session threads to the main
+// loop. push() is lock-free; drain() hands the main thread a batch where
+//  - Volume, Seek, Speed and MediaPosition keep only their latest value
+//    (a Load or Stop starts a new run, so a seek never crosses files)
+//  - playback commands come before media session display updates, each
+//    group in arrival order
+class PlayerCommandQueue {
+public:
+    // Any thread
+    void push(PlayerCommand cmd) { queue_.push(std::move(cmd)); }
+    bool empty() const { return queue_.empty(); }
+
+    // Main thread: replaces out with the next batch
+    void drain(std::vector<PlayerCommand>& out);
+
+private:
+    MpscQueue<PlayerCommand> queue_;
+    std::vector<PlayerCommand> batch_;  // main thread scratch
+};
@@ -0,0 +1,124 @@
+#include "reactor.h"
+#include "logging.h"
+#include <algorithm>
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+Reactor::Reactor() {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+        LOG_ERROR(LOG_PLATFORM, "Reactor: epoll/eventfd creation failed (errno %d)", errno);
+        return;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = wake_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+}
+
+Reactor::~Reactor() {
+    for (int timer : timers_) close(timer);
+    if (wake_fd_ >= 0) close(wake_fd_);
+    if (epoll_fd_ >= 0) close(epoll_fd_);
+}
+
+bool Reactor::add(int fd, uint32_t events, Handler handler) {
+    if (epoll_fd_ < 0 || fd < 0) return false;
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        LOG_ERROR(LOG_PLATFORM, "Reactor: cannot watch fd %d (errno %d)", fd, errno);
+        return false;
+    }
+    handlers_[fd] = std::move(handler);
+    return true;
+}
+
+bool Reactor::modify(int fd, uint32_t events) {
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = fd;
+    return epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev) == 0;
+}
+
+void Reactor::remove(int fd) {
+    if (handlers_.erase(fd)) {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    }
+}
+
+int Reactor::addTimer(Handler handler) {
+    int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer < 0) {
+        LOG_ERROR(LOG_PLATFORM, "Reactor: timerfd creation failed (errno %d)", errno);
+        return -1;
+    }
+    auto expire = [timer, handler = std::move(handler)]() {
+        uint64_t expirations;
+        [[maybe_unused]] auto _ = read(timer, &expirations, sizeof(expirations));
+        handler();
+    };
+    if (!add(timer, EPOLLIN, std::move(expire))) {
+        close(timer);
+        return -1;
+    }
+    timers_.push_back(timer);
+    return timer;
+}
+
+void Reactor::setTimer(int timer, uint64_t deadline_us) {
+    if (timer < 0) return;
+    itimerspec spec{};
+    if (deadline_us != NO_DEADLINE) {
+        // An all-zero value would disarm; past deadlines expire immediately
+        deadline_us = (std::max)(deadline_us, uint64_t{1});
+        spec.it_value.tv_sec = static_cast<time_t>(deadline_us / 1000000);
+        spec.it_value.tv_nsec = static_cast<long>(deadline_us % 1000000) * 1000;
+    }
+    timerfd_settime(timer, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+void Reactor::wake() {
+    if (wake_fd_ < 0) return;
+    uint64_t val = 1;
+    [[maybe_unused]] auto _ = write(wake_fd_, &val, sizeof(val));
+}
+
+void Reactor::stop() {
+    stopped_.store(true);
+    wake();
+}
+
+void Reactor::run() {
+    if (epoll_fd_ < 0) return;
+    constexpr int MAX_EVENTS = 8;
+    epoll_event events[MAX_EVENTS];
+
+    while (!stopped_.load()) {
+        int n = epoll_wait(epoll_fd_, events, MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR(LOG_PLATFORM, "Reactor: epoll_wait failed (errno %d)", errno);
+            return;
+        }
+        for (int i = 0; i < n && !stopped_.load(); i++) {
+            int fd = events[i].data.fd;
+            if (fd == wake_fd_) {
+                uint64_t val;
+                [[maybe_unused]] auto _ = read(wake_fd_, &val, sizeof(val));
+                if (on_wake_) on_wake_();
+                continue;
+            }
+            // Copy: the handler may remove itself
+            auto it = handlers_.find(fd);
+            if (it == handlers_.end()) continue;
+            Handler handler = it->second;
+            handler();
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// epoll event loop for the worker threads (Linux). run() sleeps until a
+// watched fd is ready, a timer expires, or another thread calls wake() or
+// stop(); there is no polling timeout. Handlers run on the run() thread.
+class Reactor {
+public:
+    using Handler = std::function<void()>;
+
+    static constexpr uint64_t NO_DEADLINE = UINT64_MAX;
+
+    Reactor();
+    ~Reactor();
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    // Reactor thread (or before run()): watch fd for epoll events (EPOLLIN, ...)
+    bool add(int fd, uint32_t events, Handler handler);
+    bool modify(int fd, uint32_t events);
+    void remove(int fd);
+
+    // One-shot timer, returns -1 on failure. Deadlines are absolute
+    // CLOCK_MONOTONIC microseconds; NO_DEADLINE disarms.
+    int addTimer(Handler handler);
+    void setTimer(int timer, uint64_t deadline_us);
+
+    // Any thread: run the wake handler on the reactor thread (coalesced)
+    void setWakeHandler(Handler handler) { on_wake_ = std::move(handler); }
+    void wake();
+
+    // Dispatch until stop() (which may be called from any thread)
+    void run();
+    void stop();
+
+private:
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::atomic<bool> stopped_{false};
+    Handler on_wake_;
+    std::unordered_map<int, Handler> handlers_;
+    std::vector<int> timers_;  // owned timerfds
+};
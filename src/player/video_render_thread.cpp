@@ -1,7 +1,8 @@
 #include "video_render_thread.h"
 #include "video_renderer.h"
 #include "logging.h"
-#include <chrono>
+#include "thread_policy.h"
+#include "trace.h"
 
 VideoRenderThread::~VideoRenderThread() {
     stop();
@@ -18,7 +19,7 @@ void VideoRenderThread::stop() {
     if (!running_.load()) return;
 
     running_.store(false);
-    cv_.notify_one();  // Wake thread so it can exit
+    wakeThread();
     if (thread_.joinable()) {
         thread_.join();
     }
@@ -37,10 +38,11 @@ void VideoRenderThread::requestResize(int width, int height) {
         resize_height_ = height;
     }
     resize_pending_.store(true);
-    cv_.notify_one();
+    wakeThread();
 }
 
 void VideoRenderThread::threadFunc() {
+    thread_policy::apply(thread_policy::Role::VideoRender);
     while (running_.load()) {
         // Handle resize first
         if (resize_pending_.exchange(false)) {
@@ -61,16 +63,16 @@ void VideoRenderThread::threadFunc() {
             int w = width_.load();
             int h = height_.load();
             if (w > 0 && h > 0 && renderer_->hasFrame()) {
+                TRACE_SCOPE("renderVideo");
                 if (renderer_->render(w, h)) {
                     video_ready_.store(true);
                 }
             }
         }
 
-        // Wait for work: frame ready, resize, colorspace, or shutdown
-        // 100ms timeout as fallback for shutdown check
+        // Sleep until there is work: frame ready, resize, colorspace, or shutdown
         std::unique_lock lock(cv_mutex_);
-        cv_.wait_for(lock, std::chrono::milliseconds(100), [this] {
+        cv_.wait(lock, [this] {
             return !running_.load() || resize_pending_.load() ||
                    colorspace_pending_.load() || frame_notified_.load();
         });
@@ -23,7 +23,7 @@ public:
     void requestResize(int width, int height);
 
     // Request colorspace setup (executed on render thread)
-    void requestSetColorspace() { colorspace_pending_.store(true); notify(); }
+    void requestSetColorspace() { colorspace_pending_.store(true); wakeThread(); }
 
     // Enable/disable rendering loop
     void setActive(bool active) {
@@ -32,7 +32,7 @@ public:
     }
 
     // Wake thread to check for new frames (called from mpv redraw callback)
-    void notify() { frame_notified_.store(true); cv_.notify_one(); }
+    void notify() { frame_notified_.store(true); wakeThread(); }
 
     // Query if video has been rendered at least once
     bool isVideoReady() const { return video_ready_.load(); }
@@ -42,6 +42,12 @@ public:
 
 private:
     void threadFunc();
+    // Call after setting a flag; taking cv_mutex_ orders the flag against
+    // the thread's predicate check so the (untimed) wait can't miss it
+    void wakeThread() {
+        { std::lock_guard<std::mutex> lock(cv_mutex_); }
+        cv_.notify_one();
+    }
 
     VideoRenderer* renderer_ = nullptr;
     std::thread thread_;
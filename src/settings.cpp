@@ -1,4 +1,5 @@
 #include "settings.h"
+#include "json_reader.h"
 #include <fstream>
 #include <sstream>
 #include <cstdlib>
@@ -57,22 +58,9 @@ bool Settings::load() {
     buffer << file.rdbuf();
     std::string content = buffer.str();
 
-    // Simple JSON parsing for serverUrl
-    size_t pos = content.find("\"serverUrl\"");
-    if (pos != std::string::npos) {
-        pos = content.find(':', pos);
-        if (pos != std::string::npos) {
-            pos = content.find('"', pos);
-            if (pos != std::string::npos) {
-                size_t end = content.find('"', pos + 1);
-                if (end != std::string::npos) {
-                    server_url_ = content.substr(pos + 1, end - pos - 1);
-                }
-            }
-        }
-    }
-
-    return true;
+    return jsonForEachMember(jsonParse(content), [this](std::string_view key, const JsonValue& value) {
+        if (key == "serverUrl") server_url_ = value.asString();
+    });
 }
 
 bool Settings::save() {
@@ -0,0 +1,126 @@
+#include "shader_cache.h"
+#include "logging.h"
+#include "version.h"
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char BLOB_MAGIC[4] = {'J', 'D', 'S', 'C'};
+constexpr uint32_t BLOB_VERSION = 1;
+constexpr uint32_t MAX_BLOB_BYTES = 16 * 1024 * 1024;
+
+struct BlobHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t size;
+};
+
+// "1.2.0 (abc1234)" -> "1.2.0__abc1234_"
+std::string versionDirName() {
+    std::string name = APP_VERSION_STRING;
+    for (char& c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '.' && c != '-') c = '_';
+    }
+    return name;
+}
+
+} // namespace
+
+ShaderCache& ShaderCache::instance() {
+    static ShaderCache instance;
+    return instance;
+}
+
+uint64_t ShaderCache::hash(const std::string& data) {
+    uint64_t h = 14695981039346656037ull;
+    for (unsigned char c : data) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+void ShaderCache::init(const std::string& dir) {
+    std::string version = versionDirName();
+    fs::path root(dir);
+    std::error_code ec;
+    fs::create_directories(root / version / "mpv", ec);
+    if (ec) {
+        LOG_WARN(LOG_GL, "Shader cache disabled: %s: %s", dir.c_str(), ec.message().c_str());
+        return;
+    }
+
+    // Drop caches written by other app versions
+    for (const auto& entry : fs::directory_iterator(root, ec)) {
+        if (entry.path().filename() != version) {
+            std::error_code rm_ec;
+            fs::remove_all(entry.path(), rm_ec);
+            LOG_DEBUG(LOG_GL, "Removed stale shader cache: %s", entry.path().string().c_str());
+        }
+    }
+
+    dir_ = (root / version).string();
+    LOG_DEBUG(LOG_GL, "Shader cache: %s", dir_.c_str());
+}
+
+std::string ShaderCache::mpvDir() const {
+    return enabled() ? (fs::path(dir_) / "mpv").string() : std::string();
+}
+
+bool ShaderCache::load(const char* name, uint64_t key, uint32_t& format, std::vector<uint8_t>& data) const {
+    if (!enabled()) return false;
+    std::string path = (fs::path(dir_) / (std::string(name) + ".bin")).string();
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+
+    BlobHeader header;
+    bool ok = fread(&header, sizeof(header), 1, f) == 1 &&
+              memcmp(header.magic, BLOB_MAGIC, sizeof(BLOB_MAGIC)) == 0 &&
+              header.version == BLOB_VERSION && header.key == key &&
+              header.size > 0 && header.size <= MAX_BLOB_BYTES;
+    if (ok) {
+        data.resize(header.size);
+        ok = fread(data.data(), 1, data.size(), f) == data.size();
+        format = header.format;
+    }
+    fclose(f);
+    if (!ok) {
+        LOG_DEBUG(LOG_GL, "Shader cache miss: %s", name);
+    }
+    return ok;
+}
+
+void ShaderCache::store(const char* name, uint64_t key, uint32_t format, const std::vector<uint8_t>& data) const {
+    if (!enabled() || data.empty() || data.size() > MAX_BLOB_BYTES) return;
+    fs::path path = fs::path(dir_) / (std::string(name) + ".bin");
+    fs::path tmp = path;
+    tmp += ".tmp";
+
+    FILE* f = fopen(tmp.string().c_str(), "wb");
+    if (!f) return;
+    BlobHeader header;
+    memcpy(header.magic, BLOB_MAGIC, sizeof(BLOB_MAGIC));
+    header.version = BLOB_VERSION;
+    header.key = key;
+    header.format = format;
+    header.size = static_cast<uint32_t>(data.size());
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+              fwrite(data.data(), 1, data.size(), f) == data.size();
+    ok = (fclose(f) == 0) && ok;
+
+    std::error_code ec;
+    if (ok) fs::rename(tmp, path, ec);
+    if (!ok || ec) {
+        fs::remove(tmp, ec);
+        LOG_WARN(LOG_GL, "Failed to write shader cache: %s", path.string().c_str());
+        return;
+    }
+    LOG_DEBUG(LOG_GL, "Stored program binary %s (%zu bytes)", name, data.size());
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Persistent shader/pipeline caches under <cache>/shaders/<app version>/.
+// Directories left by other app versions are removed at init, so an upgrade
+// (which may bundle a different mpv/libplacebo) starts cold rather than
+// feeding stale blobs to the driver. Program binaries additionally carry a
+// caller-supplied key (driver identity + source) and are ignored on mismatch.
+class ShaderCache {
+public:
+    static ShaderCache& instance();
+
+    void init(const std::string& dir);
+    bool enabled() const { return !dir_.empty(); }
+
+    // Directory for mpv's gpu-shader-cache-dir (libplacebo shaders and
+    // Vulkan pipeline cache); empty if disabled
+    std::string mpvDir() const;
+
+    // Program binary blob by name; false on miss or key mismatch
+    bool load(const char* name, uint64_t key, uint32_t& format, std::vector<uint8_t>& data) const;
+    void store(const char* name, uint64_t key, uint32_t format, const std::vector<uint8_t>& data) const;
+
+    static uint64_t hash(const std::string& data);
+
+private:
+    ShaderCache() = default;
+
+    std::string dir_;
+};
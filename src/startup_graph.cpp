@@ -0,0 +1,112 @@
+#include "startup_graph.h"
+#include <cstdio>
+#include <string>
+
+StartupGraph::StartupGraph() : origin_(Clock::now()) {}
+
+StartupGraph::~StartupGraph() {
+    for (auto& t : workers_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+StartupGraph::TaskId StartupGraph::add(const char* name, bool mainThread, std::initializer_list<TaskId> deps) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TaskId id = static_cast<TaskId>(tasks_.size());
+    Task task;
+    task.name = name;
+    task.main_thread = mainThread;
+    task.deps.assign(deps.begin(), deps.end());
+    // Nothing can start before the main thread reaches the line that adds it
+    if (last_main_ >= 0) task.deps.push_back(last_main_);
+    tasks_.push_back(std::move(task));
+    return id;
+}
+
+void StartupGraph::waitDeps(TaskId id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] {
+        for (TaskId dep : tasks_[id].deps) {
+            if (!tasks_[dep].done) return false;
+        }
+        return true;
+    });
+    tasks_[id].start = Clock::now();
+}
+
+void StartupGraph::finish(TaskId id, bool ok) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_[id].end = Clock::now();
+        tasks_[id].ok = ok;
+        tasks_[id].done = true;
+    }
+    cv_.notify_all();
+}
+
+StartupGraph::TaskId StartupGraph::async(const char* name, std::initializer_list<TaskId> deps,
+                                         std::function<bool()> fn) {
+    TaskId id = add(name, false, deps);
+    workers_.emplace_back([this, id, fn = std::move(fn)] {
+        waitDeps(id);
+        finish(id, fn());
+    });
+    return id;
+}
+
+StartupGraph::TaskId StartupGraph::begin(const char* name, std::initializer_list<TaskId> deps) {
+    TaskId id = add(name, true, deps);
+    waitDeps(id);
+    last_main_ = id;
+    return id;
+}
+
+void StartupGraph::end(TaskId id, bool ok) {
+    finish(id, ok);
+}
+
+bool StartupGraph::wait(TaskId id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] { return tasks_[id].done; });
+    return tasks_[id].ok;
+}
+
+void StartupGraph::report() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto ms = [this](Clock::time_point t) {
+        return std::chrono::duration<double, std::milli>(t - origin_).count();
+    };
+
+    printf("Startup report (ms from graph creation)\n");
+    printf("  %-24s %-7s %9s %9s %9s\n", "phase", "thread", "start", "end", "wall");
+    TaskId last = -1;
+    for (size_t i = 0; i < tasks_.size(); i++) {
+        const Task& t = tasks_[i];
+        if (!t.done) {
+            printf("  %-24s %-7s %9s\n", t.name, t.main_thread ? "main" : "worker", "running");
+            continue;
+        }
+        printf("  %-24s %-7s %9.1f %9.1f %9.1f%s\n", t.name, t.main_thread ? "main" : "worker",
+               ms(t.start), ms(t.end), ms(t.end) - ms(t.start), t.ok ? "" : "  FAILED");
+        if (last < 0 || t.end > tasks_[last].end) last = static_cast<TaskId>(i);
+    }
+    if (last < 0) return;
+
+    // Walk back from the last task to finish through whichever dependency finished last
+    std::vector<TaskId> path;
+    for (TaskId id = last; id >= 0;) {
+        path.push_back(id);
+        TaskId next = -1;
+        for (TaskId dep : tasks_[id].deps) {
+            if (tasks_[dep].done && (next < 0 || tasks_[dep].end > tasks_[next].end)) next = dep;
+        }
+        id = next;
+    }
+
+    std::string line;
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        if (!line.empty()) line += " -> ";
+        line += tasks_[*it].name;
+    }
+    printf("  critical path (%.1f ms): %s\n", ms(tasks_[last].end), line.c_str());
+}
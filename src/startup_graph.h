@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Startup task graph. Worker tasks run on their own thread once their
+// dependencies finish; main-thread phases are timed inline, in program
+// order, after waiting for their dependencies. Records per-phase wall time
+// for --startup-report.
+class StartupGraph {
+public:
+    using TaskId = int;
+    using Clock = std::chrono::steady_clock;
+
+    StartupGraph();
+    ~StartupGraph();  // joins outstanding workers
+
+    StartupGraph(const StartupGraph&) = delete;
+    StartupGraph& operator=(const StartupGraph&) = delete;
+
+    // Run fn on a worker thread after deps complete; fn's result is the task result
+    TaskId async(const char* name, std::initializer_list<TaskId> deps, std::function<bool()> fn);
+
+    // Main-thread phase: waits for deps, then times until end()
+    TaskId begin(const char* name, std::initializer_list<TaskId> deps = {});
+    void end(TaskId id, bool ok = true);
+
+    // Block until task completes; returns its result
+    bool wait(TaskId id);
+
+    // Per-phase wall time and the critical path through the graph (stdout)
+    void report();
+
+private:
+    struct Task {
+        const char* name;
+        bool main_thread;
+        std::vector<TaskId> deps;  // includes the implicit previous main-thread phase
+        Clock::time_point start;
+        Clock::time_point end;
+        bool done = false;
+        bool ok = false;
+    };
+
+    TaskId add(const char* name, bool mainThread, std::initializer_list<TaskId> deps);
+    void waitDeps(TaskId id);
+    void finish(TaskId id, bool ok);
+
+    Clock::time_point origin_;
+    std::deque<Task> tasks_;  // deque: stable references while workers append
+    std::vector<std::thread> workers_;
+    TaskId last_main_ = -1;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
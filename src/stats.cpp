@@ -0,0 +1,7 @@
+#include "stats.h"
+
+namespace stats {
+
+Counters g_counters;
+
+}  // namespace stats
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Process-wide runtime counters. Hot paths bump them with a relaxed atomic
+// add; readers (the perf HUD, the metrics endpoint) sample them and diff
+// against their last read.
+namespace stats {
+
+// Fixed-bucket latency histogram (Prometheus style: upper bounds in seconds)
+struct Histogram {
+    static constexpr size_t BUCKETS = 10;
+    static constexpr double BOUNDS[BUCKETS] = {
+        0.001, 0.002, 0.004, 0.008, 0.016, 0.033, 0.05, 0.1, 0.25, 1.0};
+
+    std::atomic<uint64_t> counts[BUCKETS + 1] = {};  // per bucket, last is +Inf
+    std::atomic<uint64_t> sum_ns{0};
+
+    void observe(double seconds) {
+        size_t i = 0;
+        while (i < BUCKETS && seconds > BOUNDS[i]) i++;
+        counts[i].fetch_add(1, std::memory_order_relaxed);
+        sum_ns.fetch_add(static_cast<uint64_t>(seconds * 1e9), std::memory_order_relaxed);
+    }
+};
+
+struct Counters {
+    std::atomic<uint64_t> cef_paints{0};      // software paints, all browsers
+    std::atomic<uint64_t> cef_gpu_paints{0};  // dmabuf / IOSurface paints
+    std::atomic<uint64_t> upload_bytes{0};    // software CEF frames uploaded to textures
+    std::atomic<uint64_t> uploads{0};         // software uploads and dmabuf imports
+    std::atomic<uint64_t> upload_ns{0};       // time spent in them
+    std::atomic<uint64_t> player_commands{0};
+    std::atomic<uint64_t> player_commands_coalesced{0};  // superseded before running
+    std::atomic<uint64_t> media_session_commands{0};     // MPRIS / Now Playing controls
+
+    // Gauges
+    std::atomic<int64_t> paint_buffer_bytes{0};  // CEF paint double buffers
+    std::atomic<int64_t> texture_bytes{0};       // compositor textures and PBOs
+
+    Histogram main_loop;  // busy time per main loop iteration
+};
+
+extern Counters g_counters;
+
+inline void add(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+    counter.fetch_add(n, std::memory_order_relaxed);
+}
+
+inline void adjust(std::atomic<int64_t>& gauge, int64_t delta) {
+    gauge.fetch_add(delta, std::memory_order_relaxed);
+}
+
+inline uint64_t read(const std::atomic<uint64_t>& counter) {
+    return counter.load(std::memory_order_relaxed);
+}
+
+inline int64_t read(const std::atomic<int64_t>& gauge) {
+    return gauge.load(std::memory_order_relaxed);
+}
+
+}  // namespace stats
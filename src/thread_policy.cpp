@@ -0,0 +1,293 @@
+#include "thread_policy.h"
+#include "logging.h"
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <pthread/qos.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <systemd/sd-bus.h>
+#endif
+
+namespace thread_policy {
+
+namespace {
+
+struct RoleInfo {
+    const char* name;  // <= 15 chars (Linux limit)
+    bool boosted;      // gets the configured priority
+    int rt_priority;   // SCHED_FIFO/SCHED_RR priority for Realtime
+    bool round_robin;  // SCHED_RR instead of SCHED_FIFO
+    int nice;          // for High, and Realtime fallback
+};
+
+// Video frames, UI compositing and mpv event delivery are latency-sensitive;
+// the browser UI thread, media session and metrics are not worth boosting
+RoleInfo roleInfo(Role role) {
+    switch (role) {
+        case Role::CefUi:        return {"CEF UI", false, 0, false, 0};
+        case Role::VideoRender:  return {"video render", true, 10, false, -10};
+        case Role::Compositor:   return {"compositor", true, 8, false, -8};
+        case Role::MpvEvents:    return {"mpv events", true, 5, true, -5};
+        case Role::MediaSession: return {"media session", false, 0, false, 0};
+        case Role::Metrics:      return {"metrics", false, 0, false, 0};
+    }
+    return {"worker", false, 0, false, 0};
+}
+
+Config g_config;
+
+std::string cpuListString(const std::vector<int>& cpus) {
+    std::string out;
+    for (int cpu : cpus) {
+        if (!out.empty()) out += ',';
+        out += std::to_string(cpu);
+    }
+    return out;
+}
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+
+pid_t currentTid() {
+    return static_cast<pid_t>(syscall(SYS_gettid));
+}
+
+// Threads made realtime through rtkit, for the SIGXCPU handler (0 = free slot)
+constexpr int MAX_RT_THREADS = 8;
+std::atomic<pid_t> g_rt_tids[MAX_RT_THREADS] = {};
+std::atomic<int> g_rt_count{0};
+
+// Soft RLIMIT_RTTIME reached: an RT thread ran 100 ms without blocking (e.g.
+// a first-frame shader compile). Drop the rtkit threads to SCHED_OTHER, which
+// stops RT time accounting, rather than reach the hard limit and SIGKILL.
+void onRtTimeExceeded(int) {
+    sched_param param{};
+    int count = std::min(g_rt_count.load(), MAX_RT_THREADS);
+    for (int i = 0; i < count; i++) {
+        pid_t tid = g_rt_tids[i].load();
+        if (tid > 0) sched_setscheduler(tid, SCHED_OTHER, &param);
+    }
+}
+
+// rtkit's MakeThreadRealtime refuses processes without an RLIMIT_RTTIME hard
+// cap at or below its RTTimeUSecMax (200 ms by default), which also protects
+// the desktop from a runaway RT thread. The soft limit sits below the hard
+// one so the kernel sends SIGXCPU first, which demotes instead of killing.
+bool limitRtTime() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_RTTIME, &limit) != 0) return false;
+    if (limit.rlim_max == RLIM_INFINITY) {
+        limit.rlim_cur = 100000;
+        limit.rlim_max = 200000;
+        if (setrlimit(RLIMIT_RTTIME, &limit) != 0) return false;
+    }
+    static const bool handler_installed = []() {
+        struct sigaction action{};
+        action.sa_handler = onRtTimeExceeded;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        return sigaction(SIGXCPU, &action, nullptr) == 0;
+    }();
+    return handler_installed;
+}
+
+// rtkit grants RT/nice boosts to unprivileged desktop processes over the
+// system bus
+bool rtkitCall(const char* method, const char* signature, uint64_t tid, int32_t value) {
+    sd_bus* bus = nullptr;
+    if (sd_bus_open_system(&bus) < 0) return false;
+    sd_bus_error error = SD_BUS_ERROR_NULL;
+    // value is a uint32 priority or an int32 nice level; both pass as int
+    int r = sd_bus_call_method(bus, "org.freedesktop.RealtimeKit1", "/org/freedesktop/RealtimeKit1",
+                               "org.freedesktop.RealtimeKit1", method, &error, nullptr, signature,
+                               tid, value);
+    if (r < 0) {
+        LOG_DEBUG(LOG_PLATFORM, "rtkit %s failed: %s", method, error.message ? error.message : strerror(-r));
+    }
+    sd_bus_error_free(&error);
+    sd_bus_unref(bus);
+    return r >= 0;
+}
+
+// Returns a description of what was applied
+std::string applyPriority(const RoleInfo& info, Priority priority) {
+    pid_t tid = currentTid();
+    if (priority == Priority::Realtime) {
+        int policy = info.round_robin ? SCHED_RR : SCHED_FIFO;
+        const char* policy_name = info.round_robin ? "SCHED_RR" : "SCHED_FIFO";
+        sched_param param{};
+        param.sched_priority = info.rt_priority;
+        // Reset on fork so anything we spawn starts at normal priority
+        if (sched_setscheduler(0, policy | SCHED_RESET_ON_FORK, &param) == 0) {
+            return std::string(policy_name) + " " + std::to_string(info.rt_priority);
+        }
+        // Without a handler the soft limit's SIGXCPU would kill us; fall back to nice
+        int slot = g_rt_count.fetch_add(1);
+        if (slot < MAX_RT_THREADS && limitRtTime()) {
+            // Publish before the boost so the handler can always demote it
+            g_rt_tids[slot].store(tid);
+            if (rtkitCall("MakeThreadRealtime", "tu", static_cast<uint64_t>(tid), info.rt_priority)) {
+                return "SCHED_RR " + std::to_string(info.rt_priority) + " via rtkit";
+            }
+            g_rt_tids[slot].store(0);
+        }
+    }
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(tid), info.nice) == 0) {
+        return "nice " + std::to_string(info.nice);
+    }
+    if (rtkitCall("MakeThreadHighPriority", "ti", static_cast<uint64_t>(tid), info.nice)) {
+        return "nice " + std::to_string(info.nice) + " via rtkit";
+    }
+    return {};
+}
+
+bool applyAffinity(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+void setOsThreadName(const char* name) {
+    pthread_setname_np(pthread_self(), name);
+}
+
+#elif defined(__APPLE__)
+
+// No unprivileged RT policy worth the complexity; QoS is what the scheduler honours
+std::string applyPriority(const RoleInfo&, Priority) {
+    if (pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0) == 0) {
+        return "QoS user-interactive";
+    }
+    return {};
+}
+
+bool applyAffinity(const std::vector<int>&) {
+    return false;  // macOS has no thread pinning API
+}
+
+void setOsThreadName(const char* name) {
+    pthread_setname_np(name);
+}
+
+#else  // _WIN32
+
+std::string applyPriority(const RoleInfo&, Priority priority) {
+    bool realtime = priority == Priority::Realtime;
+    int level = realtime ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_HIGHEST;
+    if (SetThreadPriority(GetCurrentThread(), level)) {
+        return realtime ? "THREAD_PRIORITY_TIME_CRITICAL" : "THREAD_PRIORITY_HIGHEST";
+    }
+    return {};
+}
+
+bool applyAffinity(const std::vector<int>& cpus) {
+    DWORD_PTR mask = 0;
+    for (int cpu : cpus) {
+        if (cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) mask |= DWORD_PTR(1) << cpu;
+    }
+    return mask && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+}
+
+void setOsThreadName(const char* name) {
+    // Windows 10 1607+; looked up so older systems still start
+    using SetThreadDescriptionFn = HRESULT(WINAPI*)(HANDLE, PCWSTR);
+    static auto set_description = reinterpret_cast<SetThreadDescriptionFn>(
+        GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription"));
+    if (!set_description) return;
+    std::wstring wide(name, name + strlen(name));
+    set_description(GetCurrentThread(), wide.c_str());
+}
+
+#endif
+
+}  // namespace
+
+bool parsePriority(const char* text, Priority& out) {
+    if (strcmp(text, "normal") == 0) {
+        out = Priority::Normal;
+    } else if (strcmp(text, "high") == 0) {
+        out = Priority::High;
+    } else if (strcmp(text, "realtime") == 0) {
+        out = Priority::Realtime;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseCpuList(const char* text, std::vector<int>& out) {
+    out.clear();
+    const char* p = text;
+    while (*p) {
+        char* end;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 0) return false;
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            if (end == p + 1 || last < first) return false;
+            p = end;
+        }
+        if (last > 1023) return false;
+        for (long cpu = first; cpu <= last; cpu++) out.push_back(static_cast<int>(cpu));
+        if (*p == ',' && p[1]) {
+            p++;
+        } else if (*p) {
+            return false;
+        }
+    }
+    return !out.empty();
+}
+
+void configure(const Config& config) {
+    g_config = config;
+}
+
+void apply(Role role) {
+    RoleInfo info = roleInfo(role);
+    trace::setThreadName(info.name);
+    setOsThreadName(info.name);
+
+    std::string applied;
+    if (info.boosted && g_config.priority != Priority::Normal) {
+        applied = applyPriority(info, g_config.priority);
+        if (applied.empty()) {
+            LOG_WARN(LOG_PLATFORM, "Thread '%s': priority boost not permitted, running at default priority",
+                     info.name);
+        }
+    }
+
+    if (role == Role::VideoRender && !g_config.render_cpus.empty()) {
+        std::string cpus = cpuListString(g_config.render_cpus);
+        if (applyAffinity(g_config.render_cpus)) {
+            applied += applied.empty() ? "" : ", ";
+            applied += "CPUs " + cpus;
+        } else {
+            LOG_WARN(LOG_PLATFORM, "Thread '%s': could not pin to CPUs %s", info.name, cpus.c_str());
+        }
+    }
+
+    if (!applied.empty()) {
+        LOG_INFO(LOG_PLATFORM, "Thread '%s': %s", info.name, applied.c_str());
+    }
+}
+
+}  // namespace thread_policy
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+// Per-role OS thread setup for our long-lived threads: the OS thread name
+// (visible in top/perf/debuggers), scheduling priority and CPU affinity.
+// Priority requests degrade gracefully: each role tries the strongest
+// mechanism the process is permitted to use and logs what it got.
+namespace thread_policy {
+
+enum class Priority {
+    Normal,    // names only
+    High,      // raised nice value / priority class
+    Realtime,  // SCHED_FIFO/SCHED_RR (direct or via rtkit), falling back to High
+};
+
+enum class Role {
+    CefUi,
+    VideoRender,
+    Compositor,
+    MpvEvents,
+    MediaSession,
+    Metrics,
+};
+
+struct Config {
+    Priority priority = Priority::Normal;
+    std::vector<int> render_cpus;  // video render thread affinity, empty = any
+};
+
+// "normal", "high" or "realtime"
+bool parsePriority(const char* text, Priority& out);
+// Comma-separated CPU indices and ranges, e.g. "2,3" or "4-7"
+bool parseCpuList(const char* text, std::vector<int>& out);
+
+// Main thread, before any worker thread starts
+void configure(const Config& config);
+
+// Called first thing on the thread filling role; also names it for tracing
+void apply(Role role);
+
+}  // namespace thread_policy
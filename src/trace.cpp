@@ -0,0 +1,195 @@
+#include "trace.h"
+#include "logging.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace trace {
+
+std::atomic<bool> g_enabled{false};
+
+namespace {
+
+// Per-thread capacity; events past this are dropped (and counted) rather
+// than wrapping, so the exporter never reads a slot that is being rewritten
+constexpr size_t EVENTS_PER_THREAD = 1 << 18;
+
+struct Event {
+    const char* name;
+    uint64_t ts;
+    uint64_t arg;  // duration (X), value (C) or flow id (s/f); unused otherwise
+    char phase;
+};
+
+struct ThreadBuffer {
+    int tid;
+    std::atomic<const char*> name{nullptr};
+    std::unique_ptr<Event[]> events{new Event[EVENTS_PER_THREAD]};
+    std::atomic<size_t> count{0};  // published with release after each write
+    std::atomic<size_t> dropped{0};
+};
+
+std::mutex g_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> g_buffers;  // outlive their threads
+std::string g_path;
+FILE* g_file = nullptr;  // opened by start() so a bad path fails early
+std::chrono::steady_clock::time_point g_origin;
+std::atomic<uint64_t> g_next_flow{1};
+
+thread_local ThreadBuffer* t_buffer = nullptr;
+thread_local const char* t_name = nullptr;
+
+ThreadBuffer* threadBuffer() {
+    if (!t_buffer) {
+        auto buf = std::make_unique<ThreadBuffer>();
+        buf->name.store(t_name, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(g_mutex);
+        buf->tid = static_cast<int>(g_buffers.size()) + 1;
+        t_buffer = buf.get();
+        g_buffers.push_back(std::move(buf));
+    }
+    return t_buffer;
+}
+
+void record(char phase, const char* name, uint64_t ts, uint64_t arg) {
+    if (!enabled()) return;
+    ThreadBuffer* buf = threadBuffer();
+    size_t n = buf->count.load(std::memory_order_relaxed);
+    if (n >= EVENTS_PER_THREAD) {
+        buf->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buf->events[n] = Event{name, ts, arg, phase};
+    buf->count.store(n + 1, std::memory_order_release);
+}
+
+void writeString(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; s && *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        if (static_cast<unsigned char>(*s) >= 0x20) fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+}  // namespace
+
+bool start(const char* path) {
+    if (!path || !path[0]) return false;
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_file = fopen(path, "w");
+    if (!g_file) return false;
+    g_path = path;
+    g_origin = std::chrono::steady_clock::now();
+    g_enabled.store(true, std::memory_order_release);
+    return true;
+}
+
+uint64_t now() {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - g_origin).count();
+    return static_cast<uint64_t>(ns) + 1;  // 0 means "not started" to Scope
+}
+
+uint64_t newFlowId() {
+    return g_next_flow.fetch_add(1, std::memory_order_relaxed);
+}
+
+void setThreadName(const char* name) {
+    t_name = name;
+    if (t_buffer) t_buffer->name.store(name, std::memory_order_relaxed);
+}
+
+void begin(const char* name) {
+    record('B', name, now(), 0);
+}
+
+void end(const char* name) {
+    record('E', name, now(), 0);
+}
+
+void complete(const char* name, uint64_t start_ns, uint64_t end_ns) {
+    record('X', name, start_ns, end_ns - start_ns);
+}
+
+void instant(const char* name) {
+    record('i', name, now(), 0);
+}
+
+void counter(const char* name, int64_t value) {
+    record('C', name, now(), static_cast<uint64_t>(value));
+}
+
+void flowBegin(const char* name, uint64_t id) {
+    record('s', name, now(), id);
+}
+
+void flowEnd(const char* name, uint64_t id) {
+    record('f', name, now(), id);
+}
+
+void stop() {
+    if (!g_enabled.exchange(false)) return;
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    FILE* f = g_file;
+    g_file = nullptr;
+
+    // Events still being appended by other threads after this point are
+    // simply not exported; everything below count is fully written
+    size_t total = 0;
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+    bool first = true;
+    for (const auto& buf : g_buffers) {
+        if (const char* name = buf->name.load(std::memory_order_relaxed)) {
+            fprintf(f, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":",
+                    first ? "" : ",\n", buf->tid);
+            writeString(f, name);
+            fputs("}}", f);
+            first = false;
+        }
+
+        size_t n = buf->count.load(std::memory_order_acquire);
+        total += n;
+        for (size_t i = 0; i < n; i++) {
+            const Event& e = buf->events[i];
+            fprintf(f, "%s{\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"name\":",
+                    first ? "" : ",\n", e.phase, buf->tid, e.ts / 1000.0);
+            writeString(f, e.name);
+            switch (e.phase) {
+                case 'X':
+                    fprintf(f, ",\"dur\":%.3f", e.arg / 1000.0);
+                    break;
+                case 'C':
+                    fprintf(f, ",\"args\":{\"value\":%lld}",
+                            static_cast<long long>(static_cast<int64_t>(e.arg)));
+                    break;
+                case 's':
+                    fprintf(f, ",\"cat\":\"flow\",\"id\":%llu", static_cast<unsigned long long>(e.arg));
+                    break;
+                case 'f':
+                    // Bind to the enclosing slice rather than the next one
+                    fprintf(f, ",\"cat\":\"flow\",\"id\":%llu,\"bp\":\"e\"",
+                            static_cast<unsigned long long>(e.arg));
+                    break;
+                case 'i':
+                    fputs(",\"s\":\"t\"", f);
+                    break;
+            }
+            fputc('}', f);
+            first = false;
+        }
+        if (size_t dropped = buf->dropped.load(std::memory_order_relaxed)) {
+            LOG_WARN(LOG_MAIN, "Trace buffer full on thread %d: dropped %zu events",
+                     buf->tid, dropped);
+        }
+    }
+    fputs("\n]}\n", f);
+    fclose(f);
+    LOG_INFO(LOG_MAIN, "Wrote %zu trace events to %s", total, g_path.c_str());
+}
+
+}  // namespace trace
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Low-overhead cross-thread tracing, exported as Chrome trace JSON
+// (chrome://tracing, ui.perfetto.dev). Each thread appends to its own
+// fixed-size buffer; nothing is shared on the hot path. When disabled every
+// macro is a relaxed load and a branch.
+//
+// Event names must have static storage (string literals): only the pointer
+// is recorded.
+namespace trace {
+
+extern std::atomic<bool> g_enabled;
+
+inline bool enabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+// Enable tracing; events are written to path by stop(). False if path
+// can't be opened for writing.
+bool start(const char* path);
+// Disable tracing and write the collected events. Safe to call when not started.
+void stop();
+
+// Label the calling thread in the trace viewer
+void setThreadName(const char* name);
+
+uint64_t now();  // ns since trace start
+uint64_t newFlowId();
+
+void begin(const char* name);
+void end(const char* name);
+void complete(const char* name, uint64_t start_ns, uint64_t end_ns);
+void instant(const char* name);
+void counter(const char* name, int64_t value);
+void flowBegin(const char* name, uint64_t id);
+void flowEnd(const char* name, uint64_t id);
+
+class Scope {
+public:
+    explicit Scope(const char* name) : name_(name), start_(enabled() ? now() : 0) {}
+    ~Scope() { if (start_) complete(name_, start_, now()); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+private:
+    const char* name_;
+    uint64_t start_;
+};
+
+}  // namespace trace
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+// Slice covering the rest of the enclosing block
+#define TRACE_SCOPE(name) trace::Scope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+// Unscoped slice for spans that don't map to a block; must nest on one thread
+#define TRACE_BEGIN(name) \
+    do { if (trace::enabled()) trace::begin(name); } while (0)
+#define TRACE_END(name) \
+    do { if (trace::enabled()) trace::end(name); } while (0)
+#define TRACE_INSTANT(name) \
+    do { if (trace::enabled()) trace::instant(name); } while (0)
+#define TRACE_COUNTER(name, value) \
+    do { if (trace::enabled()) trace::counter(name, static_cast<int64_t>(value)); } while (0)
+// Arrow from the slice enclosing FLOW_BEGIN to the one enclosing FLOW_END (same id)
+#define TRACE_FLOW_BEGIN(name, id) \
+    do { if (trace::enabled()) trace::flowBegin(name, id); } while (0)
+#define TRACE_FLOW_END(name, id) \
+    do { if (trace::enabled()) trace::flowEnd(name, id); } while (0)
+#define TRACE_THREAD_NAME(name) trace::setThreadName(name)
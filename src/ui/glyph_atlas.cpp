@@ -0,0 +1,157 @@
+#include "ui/glyph_atlas.h"
+#include "ui/stb_truetype.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+// Font search paths
+static const char* FONT_PATHS[] = {
+    "/usr/share/fonts/TTF/DejaVuSans.ttf",
+    "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+    "/usr/share/fonts/TTF/Hack-Regular.ttf",
+    "/usr/share/fonts/liberation/LiberationSans-Regular.ttf",
+    "/usr/share/fonts/noto/NotoSans-Regular.ttf",
+    "/usr/share/fonts/TTF/Roboto-Regular.ttf",
+    nullptr
+};
+
+bool loadUiFont(std::vector<uint8_t>& data, stbtt_fontinfo& info) {
+    for (int i = 0; FONT_PATHS[i]; i++) {
+        std::ifstream file(FONT_PATHS[i], std::ios::binary | std::ios::ate);
+        if (file) {
+            size_t size = file.tellg();
+            file.seekg(0);
+            data.resize(size);
+            file.read(reinterpret_cast<char*>(data.data()), size);
+            if (stbtt_InitFont(&info, data.data(), 0)) {
+                return true;
+            }
+        }
+    }
+    data.clear();
+    return false;
+}
+
+uint32_t utf8Next(const std::string& text, size_t& pos) {
+    constexpr uint32_t REPLACEMENT = 0xFFFD;
+    auto byte = [&](size_t i) { return static_cast<unsigned char>(text[i]); };
+
+    unsigned char lead = byte(pos++);
+    if (lead < 0x80) return lead;
+
+    int extra;
+    uint32_t cp, min;
+    if ((lead & 0xE0) == 0xC0) {
+        extra = 1; cp = lead & 0x1F; min = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        extra = 2; cp = lead & 0x0F; min = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        extra = 3; cp = lead & 0x07; min = 0x10000;
+    } else {
+        return REPLACEMENT;  // stray continuation or invalid lead byte
+    }
+
+    for (int i = 0; i < extra; i++) {
+        if (pos >= text.size() || (byte(pos) & 0xC0) != 0x80) return REPLACEMENT;
+        cp = (cp << 6) | (byte(pos++) & 0x3F);
+    }
+    if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return REPLACEMENT;
+    return cp;
+}
+
+GlyphAtlas::GlyphAtlas(const stbtt_fontinfo* font, float pixel_height)
+    : font_(font), pixel_height_(pixel_height),
+      scale_(stbtt_ScaleForPixelHeight(font, pixel_height)) {
+    reserveRows(64);
+}
+
+void GlyphAtlas::reserveRows(int rows) {
+    if (rows <= height_) return;
+    int new_height = (std::max)(height_ * 2, rows);
+    pixels_.resize(static_cast<size_t>(WIDTH) * new_height, 0);
+    height_ = new_height;
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::glyph(uint32_t codepoint) {
+    auto it = glyphs_.find(codepoint);
+    if (it != glyphs_.end()) return it->second;
+
+    Glyph g{};
+    g.index = stbtt_FindGlyphIndex(font_, static_cast<int>(codepoint));
+    int advance, lsb;
+    stbtt_GetGlyphHMetrics(font_, g.index, &advance, &lsb);
+    g.advance = advance * scale_;
+
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBox(font_, g.index, scale_, scale_, &x0, &y0, &x1, &y1);
+    g.w = (std::min)(x1 - x0, WIDTH - GLYPH_PADDING);
+    g.h = y1 - y0;
+    g.xoff = x0;
+    g.yoff = y0;
+
+    if (g.w > 0 && g.h > 0) {
+        if (shelf_x_ + g.w + GLYPH_PADDING > WIDTH) {
+            shelf_y_ += shelf_h_;
+            shelf_x_ = 0;
+            shelf_h_ = 0;
+        }
+        reserveRows(shelf_y_ + g.h + GLYPH_PADDING);
+        g.atlas_x = shelf_x_;
+        g.atlas_y = shelf_y_;
+        stbtt_MakeGlyphBitmap(font_, &pixels_[static_cast<size_t>(g.atlas_y) * WIDTH + g.atlas_x],
+                              g.w, g.h, WIDTH, scale_, scale_, g.index);
+        shelf_x_ += g.w + GLYPH_PADDING;
+        shelf_h_ = (std::max)(shelf_h_, g.h + GLYPH_PADDING);
+    } else {
+        g.w = g.h = 0;
+    }
+
+    return glyphs_.emplace(codepoint, g).first->second;
+}
+
+TextLayout GlyphAtlas::layout(const std::string& utf8) {
+    TextLayout out;
+    float pen = 0.0f;
+    int prev_index = -1;
+    for (size_t pos = 0; pos < utf8.size();) {
+        const Glyph& g = glyph(utf8Next(utf8, pos));
+        if (prev_index >= 0) {
+            pen += stbtt_GetGlyphKernAdvance(font_, prev_index, g.index) * scale_;
+        }
+        if (g.w > 0) {
+            int x = static_cast<int>(std::lround(pen)) + g.xoff;
+            out.quads.push_back({x, g.yoff, g.atlas_x, g.atlas_y, g.w, g.h});
+        }
+        pen += g.advance;
+        prev_index = g.index;
+    }
+    out.width = static_cast<int>(std::ceil(pen));
+    return out;
+}
+
+void blitText(const GlyphAtlas& atlas, const TextLayout& layout, uint8_t* bgra, int width,
+              int clip_top, int clip_bottom, int x, int baseline, uint8_t r, uint8_t g, uint8_t b) {
+    const uint8_t* glyphs = atlas.pixels();
+    int atlas_width = atlas.width();
+    for (const auto& quad : layout.quads) {
+        for (int gy = 0; gy < quad.h; gy++) {
+            int dst_y = baseline + quad.y + gy;
+            if (dst_y < clip_top || dst_y >= clip_bottom) continue;
+            const uint8_t* src = glyphs + (quad.atlas_y + gy) * atlas_width + quad.atlas_x;
+            for (int gx = 0; gx < quad.w; gx++) {
+                int dst_x = x + quad.x + gx;
+                if (dst_x < 0 || dst_x >= width) continue;
+                uint8_t alpha = src[gx];
+                if (alpha > 0) {
+                    uint8_t* px = bgra + (static_cast<size_t>(dst_y) * width + dst_x) * 4;
+                    // Opaque text over premultiplied background
+                    uint8_t inv = 255 - alpha;
+                    px[0] = (b * alpha + px[0] * inv) / 255;
+                    px[1] = (g * alpha + px[1] * inv) / 255;
+                    px[2] = (r * alpha + px[2] * inv) / 255;
+                    px[3] = alpha + px[3] * inv / 255;
+                }
+            }
+        }
+    }
+}
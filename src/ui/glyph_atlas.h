@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct stbtt_fontinfo;
+
+// Load the first system UI font found into data (which info points into)
+bool loadUiFont(std::vector<uint8_t>& data, stbtt_fontinfo& info);
+
+// Next code point of a UTF-8 string, advancing pos. Malformed sequences
+// (overlong, surrogates, truncated, > U+10FFFF) decode to U+FFFD.
+uint32_t utf8Next(const std::string& text, size_t& pos);
+
+// A laid-out line of text: glyph quads relative to the pen origin on the baseline
+struct TextLayout {
+    struct Quad {
+        int x, y;             // top-left, relative to origin/baseline
+        int atlas_x, atlas_y;
+        int w, h;
+    };
+    std::vector<Quad> quads;
+    int width = 0;
+};
+
+// 8-bit coverage atlas for one font at one pixel size. Glyphs are
+// rasterized on first use and packed into shelves; the atlas grows
+// downwards so existing coordinates stay valid.
+class GlyphAtlas {
+public:
+    GlyphAtlas(const stbtt_fontinfo* font, float pixel_height);
+
+    float pixelHeight() const { return pixel_height_; }
+
+    TextLayout layout(const std::string& utf8);
+
+    const uint8_t* pixels() const { return pixels_.data(); }
+    int width() const { return WIDTH; }
+    int height() const { return height_; }
+
+private:
+    struct Glyph {
+        int index;       // font glyph index
+        int atlas_x, atlas_y;
+        int w, h;
+        int xoff, yoff;  // bitmap box relative to the pen position
+        float advance;
+    };
+
+    const Glyph& glyph(uint32_t codepoint);
+    void reserveRows(int rows);
+
+    static constexpr int WIDTH = 256;
+    static constexpr int GLYPH_PADDING = 1;
+
+    const stbtt_fontinfo* font_;
+    float pixel_height_;
+    float scale_;
+    std::unordered_map<uint32_t, Glyph> glyphs_;
+    std::vector<uint8_t> pixels_;
+    int height_ = 0;
+    int shelf_x_ = 0;
+    int shelf_y_ = 0;
+    int shelf_h_ = 0;
+};
+
+// Draw a layout in an opaque color over a premultiplied BGRA image, pen at
+// (x, baseline), skipping rows outside [clip_top, clip_bottom)
+void blitText(const GlyphAtlas& atlas, const TextLayout& layout, uint8_t* bgra, int width,
+              int clip_top, int clip_bottom, int x, int baseline, uint8_t r, uint8_t g, uint8_t b);
@@ -1,22 +1,11 @@
 #define STB_TRUETYPE_IMPLEMENTATION
 #include "ui/stb_truetype.h"
 #include "ui/menu_overlay.h"
-#include <fstream>
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include "logging.h"
 
-// Font search paths
-static const char* FONT_PATHS[] = {
-    "/usr/share/fonts/TTF/DejaVuSans.ttf",
-    "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
-    "/usr/share/fonts/TTF/Hack-Regular.ttf",
-    "/usr/share/fonts/liberation/LiberationSans-Regular.ttf",
-    "/usr/share/fonts/noto/NotoSans-Regular.ttf",
-    "/usr/share/fonts/TTF/Roboto-Regular.ttf",
-    nullptr
-};
-
 MenuOverlay::MenuOverlay() = default;
 
 MenuOverlay::~MenuOverlay() {
@@ -25,28 +14,18 @@ MenuOverlay::~MenuOverlay() {
 
 bool MenuOverlay::init() {
     // Find and load a font
-    for (int i = 0; FONT_PATHS[i]; i++) {
-        std::ifstream file(FONT_PATHS[i], std::ios::binary | std::ios::ate);
-        if (file) {
-            size_t size = file.tellg();
-            file.seekg(0);
-            font_data_.resize(size);
-            file.read(reinterpret_cast<char*>(font_data_.data()), size);
-
-            auto* info = new stbtt_fontinfo;
-            if (stbtt_InitFont(info, font_data_.data(), 0)) {
-                font_info_ = info;
-                font_scale_ = stbtt_ScaleForPixelHeight(info, FONT_SIZE);
-                stbtt_GetFontVMetrics(info, &font_ascent_, &font_descent_, nullptr);
-                font_ascent_ = static_cast<int>(font_ascent_ * font_scale_);
-                font_descent_ = static_cast<int>(font_descent_ * font_scale_);
-                font_line_height_ = font_ascent_ - font_descent_;
-                return true;
-            }
-            delete info;
-        }
+    auto* info = new stbtt_fontinfo;
+    if (!loadUiFont(font_data_, *info)) {
+        delete info;
+        return false;
     }
-    return false;
+    font_info_ = info;
+    font_scale_ = stbtt_ScaleForPixelHeight(info, FONT_SIZE);
+    stbtt_GetFontVMetrics(info, &font_ascent_, &font_descent_, nullptr);
+    font_ascent_ = static_cast<int>(font_ascent_ * font_scale_);
+    font_descent_ = static_cast<int>(font_descent_ * font_scale_);
+    font_line_height_ = font_ascent_ - font_descent_;
+    return true;
 }
 
 void MenuOverlay::open(int x, int y, const std::vector<MenuItem>& items,
@@ -54,6 +33,7 @@ void MenuOverlay::open(int x, int y, const std::vector<MenuItem>& items,
     LOG_DEBUG(LOG_MENU, "open() called at %d,%d with %zu items", x, y, items.size());
     items_ = items;
     callback_ = callback;
+    layoutItems();
     // Offset so cursor is inside menu, not at the corner
     menu_x_ = x - PADDING_X;
     menu_y_ = y - PADDING_Y;
@@ -74,6 +54,7 @@ void MenuOverlay::close() {
     needs_redraw_ = true;  // Force compositor to redraw without menu
     callback_ = nullptr;
     items_.clear();
+    layouts_.clear();
     pixels_.clear();
     if (on_close_) on_close_();
 }
@@ -86,6 +67,7 @@ void MenuOverlay::select(int index) {
         needs_redraw_ = true;
         callback_ = nullptr;
         items_.clear();
+        layouts_.clear();
         pixels_.clear();
         if (on_close_) on_close_();
     }
@@ -95,8 +77,13 @@ bool MenuOverlay::handleMouseMove(int x, int y) {
     if (!is_open_) return false;
     int new_hover = itemAtPoint(x, y);
     if (new_hover != hover_index_) {
+        // Only the rows leaving and entering hover change
+        int old_hover = hover_index_;
         hover_index_ = new_hover;
-        render();
+        renderRow(old_hover);
+        renderRow(new_hover);
+        pixels_dirty_ = true;
+        needs_redraw_ = true;
     }
     return true;
 }
@@ -138,9 +125,18 @@ bool MenuOverlay::handleKeyDown(int key) {
     return false;
 }
 
+void MenuOverlay::setScale(float scale) {
+    if (scale <= 0.0f || scale == scale_) return;
+    scale_ = scale;
+    if (is_open_) {
+        layoutItems();
+        render();
+    }
+}
+
 int MenuOverlay::itemAtPoint(int x, int y) const {
-    if (x < menu_x_ || x >= menu_x_ + tex_width_) return -1;
-    if (y < menu_y_ || y >= menu_y_ + tex_height_) return -1;
+    if (x < menu_x_ || x >= menu_x_ + menu_width_) return -1;
+    if (y < menu_y_ || y >= menu_y_ + menu_height_) return -1;
     int rel_y = y - menu_y_;
     int idx = rel_y / ITEM_HEIGHT;
     if (idx >= 0 && idx < static_cast<int>(items_.size())) {
@@ -149,28 +145,46 @@ int MenuOverlay::itemAtPoint(int x, int y) const {
     return -1;
 }
 
-void MenuOverlay::render() {
-    if (!font_info_ || items_.empty()) return;
+void MenuOverlay::layoutItems() {
+    layouts_.clear();
+    if (!font_info_) return;
+
+    // Glyphs are rasterized at the texture's pixel size
+    float pixel_height = FONT_SIZE * scale_;
+    if (!atlas_ || atlas_->pixelHeight() != pixel_height) {
+        atlas_ = std::make_unique<GlyphAtlas>(static_cast<stbtt_fontinfo*>(font_info_), pixel_height);
+    }
+    for (const auto& item : items_) {
+        layouts_.push_back(atlas_->layout(item.label));
+    }
+}
 
-    auto* info = static_cast<stbtt_fontinfo*>(font_info_);
+void MenuOverlay::render() {
+    if (!atlas_ || items_.empty()) return;
 
-    // Calculate dimensions
+    // Calculate dimensions (layouts are in texture pixels)
     int max_text_width = 0;
-    for (const auto& item : items_) {
-        int w = 0;
-        for (char c : item.label) {
-            int advance, lsb;
-            stbtt_GetCodepointHMetrics(info, c, &advance, &lsb);
-            w += static_cast<int>(advance * font_scale_);
-        }
-        max_text_width = (std::max)(max_text_width, w);
+    for (const auto& layout : layouts_) {
+        max_text_width = (std::max)(max_text_width, layout.width);
     }
 
-    tex_width_ = (std::max)(MIN_WIDTH, max_text_width + PADDING_X * 2);
-    tex_height_ = static_cast<int>(items_.size()) * ITEM_HEIGHT;
+    menu_width_ = (std::max)(MIN_WIDTH, static_cast<int>(std::ceil(max_text_width / scale_)) + PADDING_X * 2);
+    menu_height_ = static_cast<int>(items_.size()) * ITEM_HEIGHT;
+    tex_width_ = static_cast<int>(std::ceil(menu_width_ * scale_));
+    tex_height_ = static_cast<int>(std::ceil(menu_height_ * scale_));
 
     pixels_.resize(tex_width_ * tex_height_ * 4);
 
+    for (int idx = 0; idx < static_cast<int>(items_.size()); idx++) {
+        renderRow(idx);
+    }
+    pixels_dirty_ = true;
+    needs_redraw_ = true;
+}
+
+void MenuOverlay::renderRow(int index) {
+    if (!atlas_ || index < 0 || index >= static_cast<int>(items_.size()) || pixels_.empty()) return;
+
     // Background color (dark gray)
     uint8_t bg_r = 45, bg_g = 45, bg_b = 48, bg_a = 240;
     // Hover color (lighter)
@@ -180,112 +194,34 @@ void MenuOverlay::render() {
     // Disabled text
     uint8_t ds_r = 120, ds_g = 120, ds_b = 120;
 
-    // Fill background
-    for (int y = 0; y < tex_height_; y++) {
-        int item_idx = y / ITEM_HEIGHT;
-        bool hover = (item_idx == hover_index_ && items_[item_idx].enabled);
+    const auto& item = items_[index];
+    int row_top = static_cast<int>(std::lround(index * ITEM_HEIGHT * scale_));
+    int row_bottom = (std::min)(tex_height_, static_cast<int>(std::lround((index + 1) * ITEM_HEIGHT * scale_)));
+
+    // Fill row background (premultiplied BGRA)
+    bool hover = (index == hover_index_ && item.enabled);
+    uint8_t fill_a = hover ? hv_a : bg_a;
+    uint8_t fill_b = static_cast<uint8_t>((hover ? hv_b : bg_b) * fill_a / 255);
+    uint8_t fill_g = static_cast<uint8_t>((hover ? hv_g : bg_g) * fill_a / 255);
+    uint8_t fill_r = static_cast<uint8_t>((hover ? hv_r : bg_r) * fill_a / 255);
+    for (int y = row_top; y < row_bottom; y++) {
         for (int x = 0; x < tex_width_; x++) {
             int i = (y * tex_width_ + x) * 4;
-            if (hover) {
-                pixels_[i + 0] = hv_r;
-                pixels_[i + 1] = hv_g;
-                pixels_[i + 2] = hv_b;
-                pixels_[i + 3] = hv_a;
-            } else {
-                pixels_[i + 0] = bg_r;
-                pixels_[i + 1] = bg_g;
-                pixels_[i + 2] = bg_b;
-                pixels_[i + 3] = bg_a;
-            }
-        }
-    }
-
-    // Render text for each item
-    for (size_t idx = 0; idx < items_.size(); idx++) {
-        const auto& item = items_[idx];
-        int text_y = static_cast<int>(idx) * ITEM_HEIGHT + (ITEM_HEIGHT + font_ascent_) / 2;
-        int text_x = PADDING_X;
-
-        uint8_t r = item.enabled ? tx_r : ds_r;
-        uint8_t g = item.enabled ? tx_g : ds_g;
-        uint8_t b = item.enabled ? tx_b : ds_b;
-
-        for (char c : item.label) {
-            int x0, y0, x1, y1;
-            stbtt_GetCodepointBitmapBox(info, c, font_scale_, font_scale_, &x0, &y0, &x1, &y1);
-
-            int glyph_w = x1 - x0;
-            int glyph_h = y1 - y0;
-            if (glyph_w > 0 && glyph_h > 0) {
-                std::vector<uint8_t> glyph(glyph_w * glyph_h);
-                stbtt_MakeCodepointBitmap(info, glyph.data(), glyph_w, glyph_h, glyph_w,
-                                          font_scale_, font_scale_, c);
-
-                // Blit glyph to texture
-                for (int gy = 0; gy < glyph_h; gy++) {
-                    int dst_y = text_y + y0 + gy;
-                    if (dst_y < 0 || dst_y >= tex_height_) continue;
-                    for (int gx = 0; gx < glyph_w; gx++) {
-                        int dst_x = text_x + x0 + gx;
-                        if (dst_x < 0 || dst_x >= tex_width_) continue;
-                        uint8_t alpha = glyph[gy * glyph_w + gx];
-                        if (alpha > 0) {
-                            int i = (dst_y * tex_width_ + dst_x) * 4;
-                            // Alpha blend
-                            uint8_t inv = 255 - alpha;
-                            pixels_[i + 0] = (r * alpha + pixels_[i + 0] * inv) / 255;
-                            pixels_[i + 1] = (g * alpha + pixels_[i + 1] * inv) / 255;
-                            pixels_[i + 2] = (b * alpha + pixels_[i + 2] * inv) / 255;
-                            pixels_[i + 3] = (std::max)(pixels_[i + 3], alpha);
-                        }
-                    }
-                }
-            }
-
-            int advance, lsb;
-            stbtt_GetCodepointHMetrics(info, c, &advance, &lsb);
-            text_x += static_cast<int>(advance * font_scale_);
+            pixels_[i + 0] = fill_b;
+            pixels_[i + 1] = fill_g;
+            pixels_[i + 2] = fill_r;
+            pixels_[i + 3] = fill_a;
         }
     }
 
-}
-
-void MenuOverlay::blendOnto(uint8_t* frame, int frame_width, int frame_height) {
-    if (!is_open_ || pixels_.empty()) return;
-
-    for (int y = 0; y < tex_height_; y++) {
-        int dst_y = menu_y_ + y;
-        if (dst_y < 0 || dst_y >= frame_height) continue;
+    // Blit the cached label layout from the atlas, clipped to the row
+    int text_y = row_top + static_cast<int>(std::lround((ITEM_HEIGHT + font_ascent_) / 2 * scale_));
+    int text_x = static_cast<int>(std::lround(PADDING_X * scale_));
 
-        for (int x = 0; x < tex_width_; x++) {
-            int dst_x = menu_x_ + x;
-            if (dst_x < 0 || dst_x >= frame_width) continue;
-
-            int src_i = (y * tex_width_ + x) * 4;
-            int dst_i = (dst_y * frame_width + dst_x) * 4;
-
-            uint8_t src_r = pixels_[src_i + 0];
-            uint8_t src_g = pixels_[src_i + 1];
-            uint8_t src_b = pixels_[src_i + 2];
-            uint8_t src_a = pixels_[src_i + 3];
+    uint8_t r = item.enabled ? tx_r : ds_r;
+    uint8_t g = item.enabled ? tx_g : ds_g;
+    uint8_t b = item.enabled ? tx_b : ds_b;
 
-            if (src_a == 255) {
-                // Opaque - direct copy (RGBA -> BGRA)
-                frame[dst_i + 0] = src_b;
-                frame[dst_i + 1] = src_g;
-                frame[dst_i + 2] = src_r;
-                frame[dst_i + 3] = 255;
-            } else if (src_a > 0) {
-                // Alpha blend (RGBA -> BGRA)
-                uint8_t dst_b = frame[dst_i + 0];
-                uint8_t dst_g = frame[dst_i + 1];
-                uint8_t dst_r = frame[dst_i + 2];
-                uint8_t inv = 255 - src_a;
-                frame[dst_i + 0] = (src_b * src_a + dst_b * inv) / 255;
-                frame[dst_i + 1] = (src_g * src_a + dst_g * inv) / 255;
-                frame[dst_i + 2] = (src_r * src_a + dst_r * inv) / 255;
-                frame[dst_i + 3] = 255;
-            }
-        }
-    }
+    blitText(*atlas_, layouts_[index], pixels_.data(), tex_width_, row_top, row_bottom,
+             text_x, text_y, r, g, b);
 }
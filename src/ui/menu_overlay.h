@@ -1,6 +1,8 @@
 #pragma once
 
 #include "include/cef_context_menu_handler.h"
+#include "ui/glyph_atlas.h"
+#include <memory>
 #include <string>
 #include <vector>
 #include <functional>
@@ -42,25 +44,48 @@ public:
     bool needsRedraw() const { return needs_redraw_; }
     void clearRedraw() { needs_redraw_ = false; }
 
-    // Blend menu onto BGRA frame buffer (CEF format)
-    void blendOnto(uint8_t* frame, int frame_width, int frame_height);
+    // Physical pixels per logical pixel for the menu texture
+    void setScale(float scale);
+    float scale() const { return scale_; }
+
+    // Menu texture for MenuCompositor: BGRA, premultiplied (CEF frame format),
+    // textureWidth() x textureHeight() at logical position x(), y()
+    const uint8_t* pixels() const { return pixels_.data(); }
+    int textureWidth() const { return tex_width_; }
+    int textureHeight() const { return tex_height_; }
+    int x() const { return menu_x_; }
+    int y() const { return menu_y_; }
+
+    // True once after the texture changed (open, hover, scale)
+    bool takePixelsDirty() {
+        bool dirty = pixels_dirty_;
+        pixels_dirty_ = false;
+        return dirty;
+    }
 
 private:
+    void layoutItems();
     void render();
+    void renderRow(int index);
     int itemAtPoint(int x, int y) const;
 
     StateCallback on_open_;
     StateCallback on_close_;
     bool is_open_ = false;
     bool ignore_next_up_ = false;  // Ignore the button-up that opened the menu
-    bool needs_redraw_ = false;    // Force compositor update after close
+    bool needs_redraw_ = false;    // Force a frame after open, hover change or close
+    bool pixels_dirty_ = false;    // Texture changed since the last upload
+    float scale_ = 1.0f;
     int menu_x_ = 0;
     int menu_y_ = 0;
-    int tex_width_ = 0;
+    int menu_width_ = 0;   // logical
+    int menu_height_ = 0;
+    int tex_width_ = 0;    // physical
     int tex_height_ = 0;
     int hover_index_ = -1;
 
     std::vector<MenuItem> items_;
+    std::vector<TextLayout> layouts_;  // per item, built on open
     CefRefPtr<CefRunContextMenuCallback> callback_;
     std::vector<uint8_t> pixels_;
 
@@ -71,6 +96,7 @@ private:
     int font_ascent_ = 0;
     int font_descent_ = 0;
     int font_line_height_ = 0;
+    std::unique_ptr<GlyphAtlas> atlas_;  // for FONT_SIZE * scale_, created on first open
 
     static constexpr int FONT_SIZE = 14;
     static constexpr int PADDING_X = 12;
@@ -0,0 +1,171 @@
+#include "ui/perf_hud.h"
+#include "ui/stb_truetype.h"
+#include "stats.h"
+#include "logging.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+#ifdef __APPLE__
+constexpr const char* GPU_PAINT_PATH = "IOSurface";
+#else
+constexpr const char* GPU_PAINT_PATH = "dmabuf";
+#endif
+
+template <typename... Args>
+std::string format(const char* fmt, Args... args) {
+    char buf[128];
+    snprintf(buf, sizeof(buf), fmt, args...);
+    return buf;
+}
+
+}  // namespace
+
+PerfHud::PerfHud() = default;
+
+PerfHud::~PerfHud() {
+    delete static_cast<stbtt_fontinfo*>(font_info_);
+}
+
+bool PerfHud::loadFont() {
+    auto* info = new stbtt_fontinfo;
+    if (!loadUiFont(font_data_, *info)) {
+        delete info;
+        return false;
+    }
+    font_info_ = info;
+    int descent;
+    stbtt_GetFontVMetrics(info, &font_ascent_, &descent, nullptr);
+    font_ascent_ = static_cast<int>(font_ascent_ * stbtt_ScaleForPixelHeight(info, FONT_SIZE));
+    return true;
+}
+
+void PerfHud::toggle() {
+    if (!visible_ && !font_info_ && !loadFont()) {
+        LOG_WARN(LOG_UI, "Perf HUD: no usable font found");
+        return;
+    }
+    visible_ = !visible_;
+    needs_redraw_ = true;
+    LOG_INFO(LOG_UI, "Perf HUD %s", visible_ ? "shown" : "hidden");
+    if (!visible_) {
+        pixels_.clear();
+        return;
+    }
+
+    // Rates start from now, not from when the HUD was last open
+    last_update_ = Clock::now();
+    frames_ = 0;
+    frame_ms_total_ = frame_ms_max_ = 0;
+    max_mpv_events_ = max_player_commands_ = 0;
+    last_paints_ = stats::read(stats::g_counters.cef_paints);
+    last_gpu_paints_ = stats::read(stats::g_counters.cef_gpu_paints);
+    last_upload_bytes_ = stats::read(stats::g_counters.upload_bytes);
+    lines_ = {"collecting..."};
+    render();
+}
+
+void PerfHud::recordFrame(double busy_ms) {
+    if (!visible_) return;
+    frames_++;
+    frame_ms_total_ += busy_ms;
+    frame_ms_max_ = (std::max)(frame_ms_max_, busy_ms);
+}
+
+void PerfHud::recordQueues(size_t mpv_events, size_t player_commands) {
+    if (!visible_) return;
+    max_mpv_events_ = (std::max)(max_mpv_events_, mpv_events);
+    max_player_commands_ = (std::max)(max_player_commands_, player_commands);
+}
+
+int PerfHud::msUntilUpdate() const {
+    if (!visible_) return -1;
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        last_update_ + UPDATE_INTERVAL - Clock::now());
+    return static_cast<int>((std::max)(remaining.count(), decltype(remaining)::rep(0)));
+}
+
+void PerfHud::update(const MpvPlayer::PlaybackStats* playback) {
+    if (!visible_) return;
+    auto now = Clock::now();
+    double seconds = std::chrono::duration<double>(now - last_update_).count();
+    if (seconds <= 0) return;
+
+    uint64_t paints = stats::read(stats::g_counters.cef_paints);
+    uint64_t gpu_paints = stats::read(stats::g_counters.cef_gpu_paints);
+    uint64_t upload_bytes = stats::read(stats::g_counters.upload_bytes);
+    uint64_t new_paints = paints - last_paints_;
+    uint64_t new_gpu_paints = gpu_paints - last_gpu_paints_;
+    if (new_gpu_paints > 0) {
+        paint_path_ = new_paints > 0 ? "mixed" : GPU_PAINT_PATH;
+    } else if (new_paints > 0) {
+        paint_path_ = "software";
+    }
+
+    lines_.clear();
+    lines_.push_back(format("frames  %.0f/s  avg %.2f ms  max %.2f ms", frames_ / seconds,
+                            frames_ ? frame_ms_total_ / frames_ : 0.0, frame_ms_max_));
+    lines_.push_back(format("CEF  %.0f paints/s  %.1f MB/s uploaded  (%s)",
+                            (new_paints + new_gpu_paints) / seconds,
+                            (upload_bytes - last_upload_bytes_) / seconds / (1024.0 * 1024.0), paint_path_));
+    if (playback) {
+        lines_.push_back(format("mpv  %.2f fps  dropped %lld vo / %lld dec  cache %.1f s", playback->decoder_fps,
+                                static_cast<long long>(playback->dropped_frames),
+                                static_cast<long long>(playback->decoder_drops), playback->cache_seconds));
+    } else {
+        lines_.push_back("mpv  idle");
+    }
+    lines_.push_back(format("queues  mpv events %zu  player commands %zu  (max per pass)",
+                            max_mpv_events_, max_player_commands_));
+
+    last_update_ = now;
+    frames_ = 0;
+    frame_ms_total_ = frame_ms_max_ = 0;
+    max_mpv_events_ = max_player_commands_ = 0;
+    last_paints_ = paints;
+    last_gpu_paints_ = gpu_paints;
+    last_upload_bytes_ = upload_bytes;
+    render();
+}
+
+void PerfHud::setScale(float scale) {
+    if (scale <= 0.0f || scale == scale_) return;
+    scale_ = scale;
+    if (visible_) render();
+}
+
+void PerfHud::render() {
+    if (!font_info_) return;
+
+    // Glyphs are rasterized at the texture's pixel size
+    float pixel_height = FONT_SIZE * scale_;
+    if (!atlas_ || atlas_->pixelHeight() != pixel_height) {
+        atlas_ = std::make_unique<GlyphAtlas>(static_cast<stbtt_fontinfo*>(font_info_), pixel_height);
+    }
+    std::vector<TextLayout> layouts;
+    int max_text_width = 0;
+    for (const auto& line : lines_) {
+        layouts.push_back(atlas_->layout(line));
+        max_text_width = (std::max)(max_text_width, layouts.back().width);
+    }
+
+    int padding = static_cast<int>(std::lround(PADDING * scale_));
+    tex_width_ = max_text_width + padding * 2;
+    tex_height_ = static_cast<int>(std::ceil(static_cast<int>(lines_.size()) * LINE_HEIGHT * scale_)) + padding * 2;
+
+    // Translucent black background (premultiplied BGRA)
+    pixels_.assign(static_cast<size_t>(tex_width_) * tex_height_ * 4, 0);
+    for (size_t i = 3; i < pixels_.size(); i += 4) {
+        pixels_[i] = 190;
+    }
+
+    for (size_t idx = 0; idx < layouts.size(); idx++) {
+        int baseline = padding + static_cast<int>(std::lround((idx * LINE_HEIGHT + font_ascent_) * scale_));
+        blitText(*atlas_, layouts[idx], pixels_.data(), tex_width_, 0, tex_height_, padding, baseline,
+                 220, 240, 220);
+    }
+    pixels_dirty_ = true;
+    needs_redraw_ = true;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "player/mpv/mpv_player.h"
+#include "ui/glyph_atlas.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// On-screen diagnostics: main-loop frame times, CEF paint rate, upload volume
+// and paint path, mpv decoder health and queue depths. The main loop feeds it
+// a few adds per iteration; the text is re-rendered only every
+// UPDATE_INTERVAL while visible. Drawn as a native layer by MenuCompositor.
+class PerfHud {
+public:
+    PerfHud();
+    ~PerfHud();
+
+    // The font loads on first show, so a hidden HUD costs nothing at startup
+    void toggle();
+    bool isOpen() const { return visible_; }
+    bool needsRedraw() const { return needs_redraw_; }
+    void clearRedraw() { needs_redraw_ = false; }
+
+    // Main thread, per composited frame: time spent outside the idle wait
+    void recordFrame(double busy_ms);
+    // Main thread, per iteration: items drained from each queue
+    void recordQueues(size_t mpv_events, size_t player_commands);
+
+    // Milliseconds until update() has new text to draw; -1 when hidden
+    int msUntilUpdate() const;
+    bool updateDue() const { return msUntilUpdate() == 0; }
+    // Re-render with the counters since the last update. playback is null
+    // when nothing is loaded.
+    void update(const MpvPlayer::PlaybackStats* playback);
+
+    // Texture interface shared with MenuOverlay (see MenuCompositor::snapshot)
+    void setScale(float scale);
+    const uint8_t* pixels() const { return pixels_.data(); }
+    int textureWidth() const { return tex_width_; }
+    int textureHeight() const { return tex_height_; }
+    int x() const { return MARGIN; }
+    int y() const { return MARGIN; }
+    bool takePixelsDirty() {
+        bool dirty = pixels_dirty_;
+        pixels_dirty_ = false;
+        return dirty;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    bool loadFont();
+    void render();
+
+    bool visible_ = false;
+    bool needs_redraw_ = false;
+    bool pixels_dirty_ = false;
+    float scale_ = 1.0f;
+    int tex_width_ = 0;  // physical
+    int tex_height_ = 0;
+    std::vector<uint8_t> pixels_;
+    std::vector<std::string> lines_;
+
+    // Accumulated since the last update
+    Clock::time_point last_update_;
+    int frames_ = 0;
+    double frame_ms_total_ = 0;
+    double frame_ms_max_ = 0;
+    size_t max_mpv_events_ = 0;
+    size_t max_player_commands_ = 0;
+    uint64_t last_paints_ = 0;
+    uint64_t last_gpu_paints_ = 0;
+    uint64_t last_upload_bytes_ = 0;
+    const char* paint_path_ = "none yet";
+
+    // Font data
+    std::vector<uint8_t> font_data_;
+    void* font_info_ = nullptr;  // stbtt_fontinfo*
+    int font_ascent_ = 0;
+    std::unique_ptr<GlyphAtlas> atlas_;  // for FONT_SIZE * scale_
+
+    static constexpr auto UPDATE_INTERVAL = std::chrono::milliseconds(500);
+    static constexpr int FONT_SIZE = 12;
+    static constexpr int LINE_HEIGHT = 16;
+    static constexpr int PADDING = 8;
+    static constexpr int MARGIN = 8;
+};
@@ -0,0 +1,26 @@
+// Paste target for native clipboard data. Installed in every frame, since
+// paste goes to the focused one; iframes get only this and setClipboard.
+(function() {
+    // Clipboard paste from native (bytes arrive as an ArrayBuffer)
+    window._nativePaste = function(mime, buffer) {
+        const bytes = new Uint8Array(buffer);
+
+        // For text, use execCommand which works reliably in inputs
+        if (mime.startsWith('text/')) {
+            const text = new TextDecoder().decode(bytes);
+            document.execCommand('insertText', false, text);
+            return;
+        }
+
+        // For binary (images etc), dispatch ClipboardEvent
+        const blob = new Blob([bytes], {type: mime});
+        const dt = new DataTransfer();
+        dt.items.add(new File([blob], 'paste', {type: mime}));
+        const event = new ClipboardEvent('paste', {
+            clipboardData: dt,
+            bubbles: true,
+            cancelable: true
+        });
+        document.activeElement.dispatchEvent(event);
+    };
+})();
@@ -35,17 +35,17 @@ window.jmpCheckServerConnectivity = (() => {
             pendingReject = reject;
             pendingUrl = url;
 
-            // Normalize URL
-            if (!url.startsWith('http://') && !url.startsWith('https://')) {
-                url = 'http://' + url;
-            }
-
+            // Native expands a bare host into http/https/default-port
+            // candidates and races them
             console.log('Checking connectivity:', url);
             window.jmpNative.checkServerConnectivity(url);
         });
     };
 
     checkFunc.abort = () => {
+        if (pendingUrl !== null && window.jmpNative?.cancelServerConnectivity) {
+            window.jmpNative.cancelServerConnectivity();
+        }
         if (pendingReject) {
             pendingReject(new Error('Connection cancelled'));
             pendingResolve = null;
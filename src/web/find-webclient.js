@@ -1,19 +1,15 @@
 async function tryConnect(server, spinnerStartTime = Date.now()) {
     try {
-        if (!server.startsWith("http")) {
-            server = "http://" + server;
-        }
-
         console.log("Checking connectivity to:", server);
 
         const resolvedUrl = await window.jmpCheckServerConnectivity(server);
         console.log("Server connectivity check passed");
         console.log("Resolved URL:", resolvedUrl);
 
-        // Save server URL persistently
-        window.jmpInfo.settings.main.userWebClient = server;
+        // Save the URL that answered (scheme and port now known)
+        window.jmpInfo.settings.main.userWebClient = resolvedUrl;
         if (window.jmpNative && window.jmpNative.saveServerUrl) {
-            window.jmpNative.saveServerUrl(server);
+            window.jmpNative.saveServerUrl(resolvedUrl);
         }
 
         // Ensure spinner shows for at least 1s
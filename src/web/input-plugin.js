@@ -1,4 +1,7 @@
 (function() {
+    // Server-side downscale: media session artwork never needs more than this
+    const ARTWORK_SIZE = '&maxWidth=512&maxHeight=512&quality=90';
+
     class inputPlugin {
         constructor({ playbackManager, inputManager }) {
             this.name = 'Input Plugin';
@@ -7,8 +10,6 @@
             this.playbackManager = playbackManager;
             this.inputManager = inputManager;
             this.positionInterval = null;
-            this.artworkAbortController = null;
-            this.pendingArtworkUrl = null;
             this.attachedPlayer = null;
 
             console.log('[Media] inputPlugin constructed with playbackManager:', !!playbackManager);
@@ -44,24 +45,24 @@
 
             if (itemType === 'Episode') {
                 if (item.SeriesId && item.SeriesPrimaryImageTag) {
-                    return baseUrl + '/Items/' + item.SeriesId + '/Images/Primary?tag=' + item.SeriesPrimaryImageTag + '&maxWidth=512';
+                    return baseUrl + '/Items/' + item.SeriesId + '/Images/Primary?tag=' + item.SeriesPrimaryImageTag + ARTWORK_SIZE;
                 }
                 if (item.SeasonId && item.SeasonPrimaryImageTag) {
-                    return baseUrl + '/Items/' + item.SeasonId + '/Images/Primary?tag=' + item.SeasonPrimaryImageTag + '&maxWidth=512';
+                    return baseUrl + '/Items/' + item.SeasonId + '/Images/Primary?tag=' + item.SeasonPrimaryImageTag + ARTWORK_SIZE;
                 }
             }
 
             if (mediaType === 'Audio' || itemType === 'Audio') {
                 if (item.AlbumId && item.AlbumPrimaryImageTag) {
-                    return baseUrl + '/Items/' + item.AlbumId + '/Images/Primary?tag=' + item.AlbumPrimaryImageTag + '&maxWidth=512';
+                    return baseUrl + '/Items/' + item.AlbumId + '/Images/Primary?tag=' + item.AlbumPrimaryImageTag + ARTWORK_SIZE;
                 }
             }
 
             if (imageTags.Primary && item.Id) {
-                return baseUrl + '/Items/' + item.Id + '/Images/Primary?tag=' + imageTags.Primary + '&maxWidth=512';
+                return baseUrl + '/Items/' + item.Id + '/Images/Primary?tag=' + imageTags.Primary + ARTWORK_SIZE;
             }
             if (item.BackdropImageTags && item.BackdropImageTags.length > 0 && item.Id) {
-                return baseUrl + '/Items/' + item.Id + '/Images/Backdrop/0?tag=' + item.BackdropImageTags[0] + '&maxWidth=512';
+                return baseUrl + '/Items/' + item.Id + '/Images/Backdrop/0?tag=' + item.BackdropImageTags[0] + ARTWORK_SIZE;
             }
 
             return null;
@@ -70,58 +71,18 @@
         fetchAlbumArt(item) {
             if (!item || !window.jmpNative) return;
 
-            if (this.artworkAbortController) {
-                this.artworkAbortController.abort();
-                this.artworkAbortController = null;
-            }
-
             let baseUrl = '';
             if (window.ApiClient && window.ApiClient.serverAddress) {
                 baseUrl = window.ApiClient.serverAddress();
             }
             if (!baseUrl) return;
 
+            // Fetched, cached and handed to the media session natively
             const imageUrl = this.getImageUrl(item, baseUrl);
             if (!imageUrl) {
                 console.log('[Media] No album art URL found');
-                return;
-            }
-
-            if (imageUrl === this.pendingArtworkUrl) {
-                console.log('[Media] Album art already pending for:', imageUrl);
-                return;
             }
-
-            this.pendingArtworkUrl = imageUrl;
-            this.artworkAbortController = new AbortController();
-            const signal = this.artworkAbortController.signal;
-
-            console.log('[Media] Fetching album art:', imageUrl);
-
-            fetch(imageUrl, { signal })
-                .then(response => {
-                    if (!response.ok) throw new Error('Failed to fetch image');
-                    return response.blob();
-                })
-                .then(blob => {
-                    const reader = new FileReader();
-                    reader.onloadend = () => {
-                        if (signal.aborted) return;
-                        const dataUri = reader.result;
-                        console.log('[Media] Album art fetched, sending data URI');
-                        window.jmpNative.notifyArtwork(dataUri);
-                        this.pendingArtworkUrl = null;
-                    };
-                    reader.readAsDataURL(blob);
-                })
-                .catch(err => {
-                    if (err.name === 'AbortError') {
-                        console.log('[Media] Album art fetch aborted');
-                    } else {
-                        console.log('[Media] Album art fetch failed:', err.message);
-                    }
-                    this.pendingArtworkUrl = null;
-                });
+            window.jmpNative.notifyArtwork(imageUrl || '');
         }
 
         startPositionUpdates() {
@@ -351,10 +312,6 @@
 
         destroy() {
             this.stopPositionUpdates();
-            if (this.artworkAbortController) {
-                this.artworkAbortController.abort();
-                this.artworkAbortController = null;
-            }
             if (this.attachedPlayer && window.Events) {
                 window.Events.off(this.attachedPlayer, 'playing');
                 window.Events.off(this.attachedPlayer, 'pause');
@@ -70,8 +70,7 @@
 
             this._core.handlers.onTimeUpdate = (time) => {
                 if (!this._isFadingOut) {
-                    this._core._currentTime = time;
-                    this._core._lastTimerTick = Date.now();
+                    this._core.setClockPosition(time);
                     this.events.trigger(this, 'timeupdate');
                 }
             };
@@ -98,7 +97,7 @@
 
         play(options) {
             this._started = false;
-            this._core._currentTime = null;
+            this._core.setClockPosition(null);
             this._core._duration = undefined;
             this._core.connectSignals();
             return this.setCurrentSrc(options);
@@ -112,7 +111,7 @@
 
                 const ms = (options.playerStartPositionTicks || 0) / 10000;
                 this._currentPlayOptions = options;
-                this._core._currentTime = ms;
+                this._core.setClockPosition(ms);
 
                 window.api.player.load(val,
                     { startMilliseconds: ms, autoplay: true },
@@ -126,7 +125,7 @@
         onEndedInternal() {
             this._core.stopTimeUpdateTimer();
             this.events.trigger(this, 'stopped', [{ src: this._currentSrc }]);
-            this._core._currentTime = null;
+            this._core.setClockPosition(null);
             this._currentSrc = null;
             this._currentPlayOptions = null;
         }
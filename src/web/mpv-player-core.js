@@ -9,7 +9,7 @@
             this._playRate = 1;
             this._muted = false;
             this._timeUpdateTimer = null;
-            this._lastTimerTick = null;
+            this._anchorTime = 0;
             this._hasConnection = false;
 
             this.handlers = {
@@ -22,17 +22,32 @@
             };
         }
 
-        // Timer management
+        // Playback clock: _currentTime is the position at _anchorTime (performance.now()).
+        // Native anchors from mpv win when newer; local anchors cover load and seek requests.
+        setClockPosition(ms) {
+            this._currentTime = ms;
+            this._anchorTime = performance.now();
+        }
+
+        clockTime() {
+            if (this._currentTime === null) return null;
+            const clock = window._playbackClock;
+            const now = performance.now();
+            if (clock && clock.time >= this._anchorTime) {
+                if (clock.paused) return clock.position;
+                return clock.position + (now - clock.time) * clock.rate;
+            }
+            const paused = clock ? clock.paused : this._paused;
+            if (paused) return this._currentTime;
+            const rate = clock ? clock.rate : (this._playRate || 1.0);
+            return this._currentTime + (now - this._anchorTime) * rate;
+        }
+
+        // Timer management (only drives timeupdate events; position comes from the clock)
         startTimeUpdateTimer() {
             if (this._timeUpdateTimer) return;
-            this._lastTimerTick = Date.now();
             this._timeUpdateTimer = setInterval(() => {
                 if (this._paused || this._currentTime === null) return;
-                const now = Date.now();
-                const elapsed = now - this._lastTimerTick;
-                this._lastTimerTick = now;
-                const rate = this._playRate || 1.0;
-                this._currentTime += elapsed * rate;
                 this.events.trigger(this.player, 'timeupdate');
             }, 250);
         }
@@ -89,12 +104,11 @@
         // Time
         currentTime(val) {
             if (val != null) {
-                this._currentTime = val;
-                this._lastTimerTick = Date.now();
+                this.setClockPosition(val);
                 window.api.player.seekTo(val);
                 return;
             }
-            return this._currentTime;
+            return this.clockTime();
         }
 
         currentTimeAsync() {
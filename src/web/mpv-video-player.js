@@ -88,8 +88,7 @@
 
             this._core.handlers.onTimeUpdate = (time) => {
                 if (time && !this._timeUpdated) this._timeUpdated = true;
-                this._core._currentTime = time;
-                this._core._lastTimerTick = Date.now();
+                this._core.setClockPosition(time);
                 this.events.trigger(this, 'timeupdate');
             };
 
@@ -123,7 +122,7 @@
             console.log('[Media] [MPV] play() called with options:', options);
             this._started = false;
             this._timeUpdated = false;
-            this._core._currentTime = null;
+            this._core.setClockPosition(null);
             this._endedPending = false;
             if (options.fullscreen) this.loading.show();  // fills entire web content area, not the actual screen
             await this.createMediaElement(options);
@@ -143,7 +142,7 @@
 
                 const ms = (options.playerStartPositionTicks || 0) / 10000;
                 this._currentPlayOptions = options;
-                this._core._currentTime = ms;
+                this._core.setClockPosition(ms);
 
                 const streams = options.mediaSource?.MediaStreams || [];
                 const defaultAudioIdx = options.mediaSource.DefaultAudioStreamIndex ?? -1;
@@ -216,7 +215,7 @@
 
         onEndedInternal() {
             this.events.trigger(this, 'stopped', [{ src: this._currentSrc }]);
-            this._core._currentTime = null;
+            this._core.setClockPosition(null);
             this._currentSrc = null;
             this._currentPlayOptions = null;
         }
@@ -56,7 +56,7 @@
             { key: 'video', order: 2 }
         ],
         settings: {
-            main: { enableMPV: true, fullscreen: false, userWebClient: '__SERVER_URL__' },
+            main: { enableMPV: true, fullscreen: false, userWebClient: window.jmpNative?.serverUrl || '' },
             audio: { channels: '2.0' },
             video: {
                 force_transcode_dovi: false,
@@ -245,6 +245,12 @@
         playerState.duration = ms;
         window.api.player.updateDuration(ms);
     };
+    // Playback clock anchor (interpolated by MpvPlayerCore.clockTime)
+    window._playbackClock = null;
+    window._nativeClockAnchor = function(ms, ageMs, rate, paused) {
+        playerState.position = ms;
+        window._playbackClock = { position: ms, time: performance.now() - ageMs, rate, paused };
+    };
     // Native emitters for media session control commands
     window._nativeHostInput = function(actions) {
         console.log('[Media] _nativeHostInput:', actions);